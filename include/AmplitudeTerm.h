@@ -0,0 +1,82 @@
+/*  YAP - Yet another PWA toolkit
+    Copyright 2015, Technische Universitaet Muenchen,
+    Authors: Daniel Greenwald, Johannes Rauch
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// \file
+
+#ifndef yap_AmplitudeTerm_h
+#define yap_AmplitudeTerm_h
+
+#include "Parameter.h"
+
+#include <complex>
+#include <memory>
+#include <vector>
+
+namespace yap {
+
+class ComplexCachedDataValue;
+class DataPoint;
+class DecayChannel;
+class Model;
+
+/// \struct AmplitudeTerm
+/// \brief A term of the initial-state particle's amplitude: the free
+/// amplitude of a DecayChannel, SpinAmplitude, and spin projection,
+/// multiplying the corresponding fixed amplitude summed over the
+/// initial-state particle's ParticleCombination's. If the initial-state
+/// particle is a Resonance, the fixed amplitude of each
+/// ParticleCombination is multiplied by its mass shape's amplitude.
+/// \ingroup Data
+struct AmplitudeTerm {
+    /// DecayChannel of the initial-state particle the term belongs to
+    std::shared_ptr<DecayChannel> Channel;
+
+    /// free amplitude
+    std::shared_ptr<ComplexParameter> Free;
+
+    /// fixed amplitude
+    std::shared_ptr<ComplexCachedDataValue> Fixed;
+
+    /// symmetrization indices of Fixed to sum over
+    std::vector<unsigned> SymmetrizationIndices;
+
+    /// cached amplitude of the initial-state particle's mass shape;
+    /// nullptr if the initial-state particle is not a Resonance
+    std::shared_ptr<ComplexCachedDataValue> MassShape;
+
+    /// symmetrization indices of MassShape, one for each of SymmetrizationIndices
+    std::vector<unsigned> MassShapeSymmetrizationIndices;
+
+    /// \return fixed amplitude summed over symmetrizations;
+    /// the fixed amplitudes must already be calculated for the data point
+    /// \param d DataPoint to retrieve fixed amplitudes from
+    std::complex<double> fixedAmplitude(const DataPoint& d) const;
+};
+
+/// \typedef AmplitudeTermVector
+/// \ingroup Data
+using AmplitudeTermVector = std::vector<AmplitudeTerm>;
+
+/// \return the terms of a Model's amplitude, whose sum over
+/// free amplitude times fixed amplitude is Model::amplitude
+/// \param m Model to collect terms of
+AmplitudeTermVector amplitudeTerms(const Model& m);
+
+}
+
+#endif
@@ -23,8 +23,10 @@
 
 #include "AmplitudeComponent.h"
 #include "DataAccessor.h"
+#include "DataPoint.h"
 
 #include <memory>
+#include <vector>
 
 namespace yap {
 
@@ -64,6 +66,12 @@ public:
     /// \param sm StatusManager to update
     virtual double amplitude(DataPoint& d, const std::shared_ptr<ParticleCombination>& pc, StatusManager& sm) const;
 
+    /// Calculate and cache barrier factors for all points of a block,
+    /// in loops over the block, for each symmetrization whose factors are uncalculated
+    /// \param B block of data points to calculate for
+    /// \param sm StatusManager to update, shared by all points of the block
+    void calculate(const DataPointBlock& B, StatusManager& sm) const;
+
     /// check consistency of object
     virtual bool consistent() const override
     { return DataAccessor::consistent(); }
@@ -85,6 +93,10 @@ public:
 
 private:
 
+    /// replace each element of z by sqrt(F2(L, z))
+    /// \param z squares of (radial size * breakup momentum)
+    void barrierFactors(std::vector<double>& z) const;
+
     /// raw pointer to owning DecayingParticle
     DecayingParticle* DecayingParticle_;
 
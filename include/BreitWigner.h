@@ -53,23 +53,36 @@ public:
     /// \param sm StatusManager to update
     virtual std::complex<double> amplitude(DataPoint& d, const std::shared_ptr<ParticleCombination>& pc, StatusManager& sm) const override;
 
+    /// Calculate and cache amplitudes for all points of a block,
+    /// in loops over the block
+    /// \param B block of data points to calculate for
+    /// \param sm StatusManager to update, shared by all points of the block
+    virtual void calculate(const DataPointBlock& B, StatusManager& sm) const override;
+
     /// Set parameters from ParticleTableEntry
     /// \param entry ParticleTableEntry containing information to create mass shape object
     virtual void setParameters(const ParticleTableEntry& entry) override;
 
     /// Get width
-    std::shared_ptr<RealParameter> width()
+    const std::shared_ptr<RealParameter>& width()
     { return Width_; }
 
     /// Get width (const)
-    const std::shared_ptr<RealParameter> width() const
-    { return const_cast<BreitWigner*>(this)->width(); }
+    const std::shared_ptr<RealParameter>& width() const
+    { return Width_; }
 
     virtual bool consistent() const override;
 
     virtual std::string data_accessor_type() const override
     {return "BreitWigner"; }
 
+protected:
+
+    /// Calculate complex amplitude without caching
+    /// \param d DataPoint to calculate with
+    /// \param pc (shared_ptr to) ParticleCombination to calculate for
+    virtual std::complex<double> calc(const DataPoint& d, const std::shared_ptr<ParticleCombination>& pc) const override;
+
 private:
 
     std::shared_ptr<RealParameter> Width_; ///< [GeV]
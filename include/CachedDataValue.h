@@ -22,6 +22,7 @@
 #define yap_CachedDataValue_h
 
 #include "CalculationStatus.h"
+#include "Exceptions.h"
 #include "FourVector.h"
 #include "Parameter.h"
 #include "VariableStatus.h"
@@ -78,6 +79,14 @@ class CachedDataValue : public std::enable_shared_from_this<CachedDataValue>
 {
 public:
 
+    /// \typedef Reader
+    /// function reading an element of a DataPoint's storage
+    using Reader = double (*)(const DataPoint&, unsigned);
+
+    /// \typedef Writer
+    /// function writing an element of a DataPoint's storage
+    using Writer = void (*)(DataPoint&, unsigned, double);
+
     /// \struct stores calculation and variable statuses for a CachedDataValue
     struct Status {
         /// constructor
@@ -89,6 +98,10 @@ public:
         /// Variable status
         VariableStatus Variable;
 
+        /// epoch of owning StatusManager at which Calculation was last set;
+        /// managed by StatusManager
+        unsigned Epoch;
+
         /// assignment of Calculation
         void operator=(const CalculationStatus& s)
         { Calculation = s; }
@@ -169,12 +182,22 @@ public:
     int index() const
     { return Index_; }
 
+    /// \return position of first element within owner's storage row
+    int position() const
+    { return Position_; }
+
     /// Get value from #DataPoint for particular symmetrization
     /// \param index index of value to get from within cached value (must be less than #Size_)
     /// \param d #DataPoint to get value from
     /// \param sym_index index of symmetrization to grab from
     /// \return Value of CachedDataValue inside the data point
-    double value(unsigned index, const DataPoint& d, unsigned sym_index) const;
+    double value(unsigned index, const DataPoint& d, unsigned sym_index) const
+    {
+#ifndef ELPP_DISABLE_DEBUG_LOGS
+        checkAccess(index, sym_index, "CachedDataValue::value");
+#endif
+        return Read_(d, Offsets_[sym_index] + index);
+    }
 
     /// \return Size of cached value (number of real elements)
     virtual unsigned size() const
@@ -203,7 +226,13 @@ public:
     /// \param val Value to set to
     /// \param d #DataPoint to update
     /// \param sym_index index of symmetrization to apply to
-    void setValue(unsigned index, double val, DataPoint& d, unsigned sym_index) const;
+    void setValue(unsigned index, double val, DataPoint& d, unsigned sym_index) const
+    {
+#ifndef ELPP_DISABLE_DEBUG_LOGS
+        checkAccess(index, sym_index, "CachedDataValue::setValue");
+#endif
+        Write_(d, Offsets_[sym_index] + index, val);
+    }
 
     /// @}
 
@@ -226,8 +255,20 @@ protected:
     void setPosition(int p)
     { Position_ = p; }
 
+    /// set offsets of owner's storage rows inside a DataPoint and choose
+    /// how values are read and written from owner's storage settings
+    /// \param offsets offsets of owner's rows, by symmetrization index (see Model::dataOffsets())
+    void setDataOffsets(const std::vector<unsigned>& offsets);
+
 private:
 
+    /// throw if index or symmetrization index is out of range
+    void checkAccess(unsigned index, unsigned sym_index, const std::string& func) const
+    {
+        if (index >= Size_ or sym_index >= Offsets_.size())
+            throw exceptions::Exception("index out of range", func);
+    }
+
     /// Owning DataAccessor
     DataAccessor* Owner_;
 
@@ -240,6 +281,16 @@ private:
     /// Size of cached value (number of real elements)
     unsigned Size_;
 
+    /// offsets of first element of cached value inside a DataPoint's
+    /// storage, by symmetrization index; set by the owner
+    std::vector<unsigned> Offsets_;
+
+    /// reads elements of owner's storage
+    Reader Read_;
+
+    /// writes elements of owner's storage
+    Writer Write_;
+
     ParameterSet ParametersItDependsOn_;
     CachedDataValueSet CachedDataValuesItDependsOn_;
     DaughterCachedDataValueSet DaughterCachedDataValuesItDependsOn_;
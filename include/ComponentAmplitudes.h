@@ -0,0 +1,104 @@
+/*  YAP - Yet another PWA toolkit
+    Copyright 2015, Technische Universitaet Muenchen,
+    Authors: Daniel Greenwald, Johannes Rauch
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// \file
+
+#ifndef yap_ComponentAmplitudes_h
+#define yap_ComponentAmplitudes_h
+
+#include "Parameter.h"
+
+#include <complex>
+#include <vector>
+
+namespace yap {
+
+class DataSet;
+class Model;
+
+/// \class ComponentAmplitudes
+/// \brief Per-data-point amplitudes of the components multiplying each
+/// free amplitude of the initial-state particle's DecayChannel's
+/// \author Johannes Rauch, Daniel Greenwald
+/// \ingroup Data
+///
+/// When all other parameters of a Model are fixed (see
+/// Model::linearInFreeAmplitudes), the amplitude of a data point is
+/// A(x) = sum_k c_k * F_k(x), with c_k the free amplitudes. The F_k
+/// are calculated once for all data points; evaluating the amplitude
+/// afterwards costs K complex multiplications per data point and
+/// requires neither the decay tree nor a StatusManager.
+class ComponentAmplitudes
+{
+public:
+
+    /// Constructor; calculates component amplitudes for all points in data set
+    /// \param m Model to calculate with; must be linear in free amplitudes
+    /// \param data DataSet to calculate for
+    ComponentAmplitudes(const Model& m, DataSet& data);
+
+    /// \return free amplitudes, in order of components
+    const ComplexParameterVector& freeAmplitudes() const
+    { return FreeAmplitudes_; }
+
+    /// \return number of data points
+    size_t nDataPoints() const
+    { return NDataPoints_; }
+
+    /// \return number of components
+    size_t nComponents() const
+    { return FreeAmplitudes_.size(); }
+
+    /// \return component amplitude
+    /// \param i index of data point
+    /// \param k index of component
+    const std::complex<double>& component(size_t i, size_t k) const
+    { return Components_[i * nComponents() + k]; }
+
+    /// \return amplitude for data point, using current values of free amplitudes
+    /// \param i index of data point
+    std::complex<double> amplitude(size_t i) const;
+
+    /// \return sum of logs of squared amplitudes over all data points,
+    /// using current values of free amplitudes
+    double sumOfLogsOfSquaredAmplitudes() const;
+
+private:
+
+    /// \return amplitude for data point
+    /// \param i index of data point
+    /// \param c values of free amplitudes
+    std::complex<double> amplitude(size_t i, const std::vector<std::complex<double> >& c) const;
+
+    /// \return current values of free amplitudes
+    std::vector<std::complex<double> > freeAmplitudeValues() const;
+
+    /// free amplitudes multiplying the components
+    ComplexParameterVector FreeAmplitudes_;
+
+    /// number of data points
+    size_t NDataPoints_;
+
+    /// component amplitudes: index = data point * nComponents() + component
+    std::vector<std::complex<double> > Components_;
+
+};
+
+}
+
+#endif
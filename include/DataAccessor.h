@@ -28,11 +28,22 @@
 
 #include <memory>
 #include <set>
+#include <vector>
 
 namespace yap {
 
 class DataPoint;
 
+/// \enum StoragePrecision
+/// \brief precision with which a DataAccessor's values are stored in a DataPoint
+/// \ingroup Data
+enum StoragePrecision {
+    /// values are stored as double's
+    kDoublePrecision,
+    /// values are stored as float's and widened to double on read
+    kSinglePrecision
+};
+
 /// \name DataAccessor
 /// \brief Abstract base class for all objects accessing DataPoint's
 /// \author Johannes Rauch, Daniel Greenwald
@@ -56,7 +67,11 @@ public:
 
     /// \return if the given ParticleCombination is in SymmetrizationIndices_
     bool hasParticleCombination(const std::shared_ptr<ParticleCombination>& c) const
-    { return SymmetrizationIndices_.find(c) != SymmetrizationIndices_.end(); }
+    {
+        if (c->id() >= 0 and c->id() < (int)SymmetrizationIndexTable_.size())
+            return SymmetrizationIndexTable_[c->id()] >= 0;
+        return SymmetrizationIndices_.find(c) != SymmetrizationIndices_.end();
+    }
 
     /// \return if the given ParticleCombination is in SymmetrizationIndices_
     /// \param c ParticleCombination to look for equivalent of
@@ -66,7 +81,11 @@ public:
 
     /// \return index inside row of DataPoint for the requested ParticleCombination
     unsigned symmetrizationIndex(const std::shared_ptr<ParticleCombination>& c) const
-    { return SymmetrizationIndices_.at(c); }
+    {
+        if (c->id() >= 0 and c->id() < (int)SymmetrizationIndexTable_.size() and SymmetrizationIndexTable_[c->id()] >= 0)
+            return SymmetrizationIndexTable_[c->id()];
+        return SymmetrizationIndices_.at(c);
+    }
 
     /// \return SymmetrizationIndices_
     const ParticleCombinationMap<unsigned>& symmetrizationIndices() const
@@ -92,6 +111,18 @@ public:
     unsigned size() const
     { return Size_; }
 
+    /// \return precision with which values are stored in data points
+    StoragePrecision precision() const
+    { return Precision_; }
+
+    /// \return whether values are recomputed for each evaluation rather than stored in data points
+    bool recomputed() const
+    { return Recomputed_; }
+
+    /// \return whether values are static, i.e. stored apart from parameter-dependent values
+    bool isStatic() const
+    { return Static_; }
+
     /// Check consistency of object
     bool consistent() const;
 
@@ -128,6 +159,27 @@ protected:
     void setIndex(size_t i)
     { Index_ = i; }
 
+    /// set precision with which values are stored in data points
+    void setPrecision(StoragePrecision p)
+    { Precision_ = p; }
+
+    /// set whether values are recomputed for each evaluation rather than stored in data points
+    void setRecomputed(bool r)
+    { Recomputed_ = r; }
+
+    /// mark values as static
+    void setStatic()
+    { Static_ = true; }
+
+    /// pass offsets of storage rows inside a DataPoint on to CachedDataValue's
+    /// \param offsets offsets of rows, by symmetrization index (see Model::dataOffsets())
+    void setDataOffsets(const std::vector<unsigned>& offsets)
+    { for (auto& c : CachedDataValues_) c->setDataOffsets(offsets); }
+
+    /// build table of symmetrization indices by ParticleCombination ID
+    /// \param n number of ParticleCombination ID's assigned
+    void buildSymmetrizationIndexTable(unsigned n);
+
 private:
 
     /// Object to check equality of symmetrizations for determining storage indices
@@ -136,6 +188,10 @@ private:
     /// Map of indices for each used symmetrization stored with key = shared_ptr<ParticleCombination>
     ParticleCombinationMap<unsigned> SymmetrizationIndices_;
 
+    /// symmetrization indices by ParticleCombination ID, -1 for those not in SymmetrizationIndices_;
+    /// ParticleCombination's without ID or beyond the table are looked up in SymmetrizationIndices_
+    std::vector<int> SymmetrizationIndexTable_;
+
     /// Set of CachedDataValues that have this DataAccessor as an owner
     CachedDataValueSet CachedDataValues_;
 
@@ -145,6 +201,15 @@ private:
     /// storage index used in DataPoint. Must be unique.
     int Index_;
 
+    /// precision with which values are stored in data points
+    StoragePrecision Precision_;
+
+    /// whether values are recomputed for each evaluation rather than stored in data points
+    bool Recomputed_;
+
+    /// whether values are static
+    bool Static_;
+
 };
 
 /// \typedef DataAccessorSet
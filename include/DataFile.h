@@ -0,0 +1,95 @@
+/*  YAP - Yet another PWA toolkit
+    Copyright 2015, Technische Universitaet Muenchen,
+    Authors: Daniel Greenwald, Johannes Rauch
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// \file
+/// Binary data-set file format, written by DataSet::write: a
+/// DataFileHeader, then the data layout description, then, beginning
+/// at a page-aligned offset, one column per static data element, each
+/// holding ColumnCapacity values.
+
+#ifndef yap_DataFile_h
+#define yap_DataFile_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace yap {
+
+class Model;
+
+/// \struct DataFileHeader
+/// \brief Header of a binary data-set file
+/// \ingroup Data
+struct DataFileHeader {
+    /// identifies file as YAP data-set file
+    char Magic[8];
+    /// version of file format
+    uint32_t Version;
+    /// size of data layout description [bytes]
+    uint32_t LayoutSize;
+    /// number of data points
+    uint64_t NPoints;
+    /// number of data points each column can hold
+    uint64_t ColumnCapacity;
+    /// number of columns (of static data)
+    uint64_t NColumns;
+    /// offset of first column from beginning of file [bytes]
+    uint64_t ColumnsOffset;
+
+    /// \return offset of element of a column from beginning of file [bytes]
+    /// \param column index of column
+    /// \param point index of data point
+    uint64_t offset(size_t column, size_t point) const
+    { return ColumnsOffset + (column * ColumnCapacity + point) * sizeof(double); }
+};
+
+/// \return binary description of the layout of a model's data points:
+/// for each DataAccessor, in order of index, its type, whether it is
+/// static, its size, its precision, whether it is recomputed, and the
+/// offsets of its rows
+/// \param m Model to describe
+std::string dataLayoutDescription(const Model& m);
+
+/// \return header for a file holding a model's data, with page-aligned columns
+/// \param m Model whose data is written
+/// \param n_points number of data points written
+DataFileHeader dataFileHeader(const Model& m, size_t n_points);
+
+/// \return header of a data-set file, checked against a model;
+/// throws if the file is not a data-set file of a supported version,
+/// its layout does not match the model's, or it is truncated
+/// \param data pointer to beginning of file
+/// \param n number of bytes available at data (at least header and layout description)
+/// \param file_size size of file [bytes]
+/// \param m Model to check against
+/// \param filename name of file, for error messages
+DataFileHeader readDataFileHeader(const char* data, size_t n, size_t file_size, const Model& m, const std::string& filename);
+
+/// \return whether each DataAccessor, in order of index, was recomputed
+/// rather than stored in the data layout of a data-set file;
+/// throws if the file is not a data-set file of a supported version
+/// \param data pointer to beginning of file
+/// \param n number of bytes available at data (at least header and layout description)
+/// \param filename name of file, for error messages
+std::vector<bool> readRecomputedDataAccessors(const char* data, size_t n, const std::string& filename);
+
+}
+
+#endif
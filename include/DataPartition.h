@@ -124,6 +124,12 @@ public:
     virtual const DataIterator& end() const
     { return End_; }
 
+    /// prepare a new iteration over the partition;
+    /// partitions streaming their data rewind their source
+    /// \return begin iterator
+    virtual const DataIterator& restart()
+    { return begin(); }
+
     /// grant friend status to DataIterator to call increment
     friend DataIterator;
 
@@ -141,10 +147,20 @@ protected:
     /// Must be overloaded in derived classes
     virtual void increment(DataIterator& it) = 0;
 
+    /// \return whether incrementing past it may overwrite the data points
+    /// iterated over so far, which then can't be evaluated in one block with later ones
+    /// \param it DataIterator to check
+    virtual bool endsBlock(const DataIterator& it) const
+    { return false; }
+
     /// \return vector<DataPoint> iterator inside DataIterator
     DataPointVector::iterator& rawIterator(DataIterator& it)
     { return it.Iterator_; }
 
+    /// \return vector<DataPoint> iterator inside DataIterator
+    const DataPointVector::iterator& rawIterator(const DataIterator& it) const
+    { return it.Iterator_; }
+
     /// set begin
     const DataIterator& setBegin(const DataPointVector::iterator& it)
     { Begin_ = DataIterator(this, it); return Begin_; }
@@ -0,0 +1,205 @@
+/*  YAP - Yet another PWA toolkit
+    Copyright 2015, Technische Universitaet Muenchen,
+    Authors: Daniel Greenwald, Johannes Rauch
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// \file
+
+#ifndef yap_DataPartitionStream_h
+#define yap_DataPartitionStream_h
+
+#include "DataFile.h"
+#include "DataPartition.h"
+#include "DataSet.h"
+
+#include <condition_variable>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace yap {
+
+class Model;
+
+/// \class DataPartitionStream
+/// \brief A partition streaming its data from a file written by DataSet::write
+/// \author Johannes Rauch, Daniel Greenwald
+/// \ingroup Data
+///
+/// Data points are read in chunks of fixed size into a small number of
+/// buffers, which are reused in turn: while the points of one chunk are
+/// iterated over, a reader thread owned by the partition reads the next
+/// chunks. Only the static columns are read; all other columns are
+/// recalculated for every chunk, so the global statuses the partition
+/// inherits from (e.g., a DataSet's) must not mark them as calculated.
+/// Only one iteration over the partition may be in progress at a time;
+/// it must be started with restart(), which rewinds the stream; begin()
+/// equals end() once an iteration has finished.
+/// The Model must have prepared its data accessors and adopted the
+/// file's storage policies (see Model::adoptStoragePolicies)
+/// and must not change while the partition exists.
+class DataPartitionStream : public DataPartitionBase
+{
+public:
+
+    /// Constructor, streaming all data points in a file
+    /// \param m Model to which the data belong; its layout must match the file's
+    /// \param filename name of file to stream from
+    /// \param chunk_size number of data points per chunk
+    /// \param n_buffers number of chunks held in memory (2 for double buffering)
+    DataPartitionStream(const Model& m, const std::string& filename, size_t chunk_size = 16384, unsigned n_buffers = 2);
+
+    /// Destructor; stops reader thread and closes file
+    ~DataPartitionStream();
+
+    /// copy constructor (deleted)
+    DataPartitionStream(const DataPartitionStream&) = delete;
+
+    /// copy assignment operator (deleted)
+    DataPartitionStream& operator=(const DataPartitionStream&) = delete;
+
+    /// restart stream, waiting for the first chunk to be read
+    /// \return begin iterator
+    const DataIterator& restart() override;
+
+    /// \return number of data points streamed
+    size_t size() const
+    { return Last_ - First_; }
+
+    /// \return DataPartitionVector streaming a file in contiguous ranges
+    /// \param m Model to which the data belong; its layout must match the file's
+    /// \param filename name of file to stream from
+    /// \param n number of partitions to divide the file into
+    /// \param chunk_size number of data points per chunk
+    /// \param n_buffers number of chunks held in memory by each partition
+    static DataPartitionVector create(const Model& m, const std::string& filename, unsigned n,
+                                      size_t chunk_size = 16384, unsigned n_buffers = 2);
+
+protected:
+
+    /// Constructor, streaming a range of data points in a file
+    /// \param m Model to which the data belong; its layout must match the file's
+    /// \param filename name of file to stream from
+    /// \param chunk_size number of data points per chunk
+    /// \param n_buffers number of chunks held in memory
+    /// \param first index of first data point to stream
+    /// \param last index of data point after last one to stream (limited to number in file)
+    DataPartitionStream(const Model& m, const std::string& filename, size_t chunk_size, unsigned n_buffers,
+                        size_t first, size_t last);
+
+    /// increment DataIterator, moving on to next chunk at end of a chunk
+    /// \param it DataIterator to iterate
+    virtual void increment(DataIterator& it) override;
+
+    /// \return whether it is the last data point of its chunk,
+    /// whose buffer is reused when incrementing past it
+    /// \param it DataIterator to check
+    virtual bool endsBlock(const DataIterator& it) const override
+    { return std::next(rawIterator(it)) == ChunkEnd_; }
+
+private:
+
+    /// \return number of chunks
+    size_t nChunks() const
+    { return (size() + ChunkSize_ - 1) / ChunkSize_; }
+
+    /// \return number of data points in chunk
+    /// \param chunk index of chunk
+    size_t chunkSize(size_t chunk) const
+    { return std::min(ChunkSize_, size() - chunk * ChunkSize_); }
+
+    /// read static columns of chunk into its buffer
+    /// \param chunk index of chunk
+    void read(size_t chunk);
+
+    /// loop run by reader thread, reading chunks as their buffers are released
+    void readChunks();
+
+    /// release buffer of finished chunk to reader thread
+    /// \param chunk index of finished chunk
+    void release(size_t chunk);
+
+    /// wait for chunk to be read; rethrows exception from reading, if any
+    /// \return iterator to its first data point
+    /// \param chunk index of chunk
+    DataPointVector::iterator waitFor(size_t chunk);
+
+    /// stop and join reader thread
+    void stop();
+
+    /// name of file
+    std::string Filename_;
+
+    /// file descriptor
+    int File_;
+
+    /// header of file
+    DataFileHeader Header_;
+
+    /// index of first data point streamed
+    size_t First_;
+
+    /// index of data point after last one streamed
+    size_t Last_;
+
+    /// number of data points per chunk
+    size_t ChunkSize_;
+
+    /// number of buffers
+    size_t NBuffers_;
+
+    /// column-major data set holding all buffers one after another;
+    /// chunk i is read into buffer i % NBuffers_,
+    /// and the end of its points marks the end of the stream
+    DataSet Buffers_;
+
+    /// index of chunk being iterated over
+    size_t Chunk_;
+
+    /// end of chunk being iterated over
+    DataPointVector::iterator ChunkEnd_;
+
+    /// reader thread
+    std::thread Reader_;
+
+    /// mutex guarding all below
+    std::mutex Mutex_;
+
+    /// signals reader thread and waitFor() of changes
+    std::condition_variable Changed_;
+
+    /// number of chunks read since last restart
+    size_t Read_;
+
+    /// number of chunks whose buffers are free to be read into
+    size_t Released_;
+
+    /// whether the reader thread is reading a chunk
+    bool Reading_;
+
+    /// whether the reader thread should stop
+    bool Stop_;
+
+    /// exception thrown while reading, if any
+    std::exception_ptr Exception_;
+
+};
+
+}
+
+#endif
@@ -25,6 +25,7 @@
 #include "FourVector.h"
 #include "ReportsModel.h"
 
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -32,6 +33,7 @@ namespace yap {
 
 class DataSet;
 class Model;
+class RecomputedStaticData;
 
 /// \class DataPoint
 /// \brief Class for holding data and cached values per data point for fast calculation
@@ -45,6 +47,19 @@ public:
     /// \param S DataAccessorSet to initialize data structure from
     DataPoint(DataSet* dataSet);
 
+    /// Copy constructor; a copy of a point stored in a column-major
+    /// DataSet's columns owns a copy of its data
+    DataPoint(const DataPoint& other);
+
+    /// Move constructor (defaulted)
+    DataPoint(DataPoint&& other) = default;
+
+    /// Copy assignment operator; see copy constructor
+    DataPoint& operator=(const DataPoint& other);
+
+    /// Move assignment operator (defaulted)
+    DataPoint& operator=(DataPoint&& other) = default;
+
     /// set four momenta of data point
     /// \param P vector of FourVectors of final-state momenta
     /// \param sm StatusManager to update
@@ -55,33 +70,29 @@ public:
     void setFinalStateMomenta(const std::vector<FourVector<double> >& P);
 
     /// \return number of data accessor rows
-    size_t nDataAccessors() const
-    { return Data_.size(); }
+    size_t nDataAccessors() const;
 
     /// \return number of sym indices rows for data accessor
     /// \param i index of DataAccessor
-    size_t nSymIndices(unsigned i) const
-    { return Data_[i].size(); }
+    size_t nSymIndices(unsigned i) const;
 
     /// \return number of elements for data accessor
     /// \param i index of DataAccessor
     /// \param j index of symmetrization
-    size_t nElements(unsigned i, unsigned j = 0) const
-    { return Data_[i][j].size(); }
+    size_t nElements(unsigned i, unsigned j = 0) const;
 
     /// \return size of data point
     unsigned dataSize() const;
 
     /// \return string of size of data point
     std::string dataSizeString() const
-    { return "Size of DataPoint: " + std::to_string(dataSize()) + " byte (for " + std::to_string(Data_.size()) + " data accessors"; }
+    { return "Size of DataPoint: " + std::to_string(dataSize()) + " byte (for " + std::to_string(nDataAccessors()) + " data accessors"; }
 
     /// check that two DataPoint's have same internal structure
     friend bool equalStructure(const DataPoint& A, const DataPoint& B);
 
     /// check that two DataPoint's are equal
-    friend bool operator==(const DataPoint& lhs, const DataPoint& rhs)
-    { return lhs.Data_ == rhs.Data_; }
+    friend bool operator==(const DataPoint& lhs, const DataPoint& rhs);
 
     const DataSet* dataSet() const
     { return DataSet_; }
@@ -95,16 +106,137 @@ public:
     /// grant friend status to DataSet to set itself owner
     friend DataSet;
 
+    /// grant friend status to RecomputedStaticData to point this at its storage
+    friend RecomputedStaticData;
+
 private:
 
+    /// \return whether storage is owned by this or by the DataSet's columns
+    bool ownsData() const
+    { return Base_ == Data_.data(); }
+
+    /// copy data of another point into Data_ and point storage at it
+    void copyData(const DataPoint& other);
+
+    /// point storage at column-major buffers
+    /// \param base pointer to this point's element in the first static column
+    /// \param stride distance between consecutive static columns
+    /// \param dynamic_base pointer to this point's element in the first parameter-dependent column
+    /// \param dynamic_stride distance between consecutive parameter-dependent columns
+    void setStorage(double* base, size_t stride, double* dynamic_base, size_t dynamic_stride)
+    { Base_ = base; Stride_ = stride; DynamicBase_ = dynamic_base; DynamicStride_ = dynamic_stride; }
+
+    /// \return element of static storage
+    /// \param i index of element (as given by Model::dataOffsets())
+    double& element(unsigned i)
+    { return Base_[i * Stride_]; }
+
+    /// \return element of static storage (const)
+    /// \param i index of element (as given by Model::dataOffsets())
+    const double& element(unsigned i) const
+    { return Base_[i * Stride_]; }
+
+    /// \return element of parameter-dependent storage
+    /// \param i index of element (as given by Model::dataOffsets())
+    double& dynamicElement(unsigned i)
+    { return DynamicBase_[i * DynamicStride_]; }
+
+    /// \return element of parameter-dependent storage (const)
+    /// \param i index of element (as given by Model::dataOffsets())
+    const double& dynamicElement(unsigned i) const
+    { return DynamicBase_[i * DynamicStride_]; }
+
+    /// \return single-precision element of storage, two of which share each element
+    /// \param i index of single-precision element (as given by Model::dataOffsets())
+    float singleElement(unsigned i) const
+    {
+        float f;
+        std::memcpy(&f, reinterpret_cast<const char*>(&element(i / 2)) + (i % 2) * sizeof(float), sizeof(float));
+        return f;
+    }
+
+    /// \return element of storage of recomputed values;
+    /// throws if there is none (see RecomputedStaticData)
+    /// \param i index of element (as given by Model::dataOffsets())
+    double& recomputedElement(unsigned i) const
+    {
+        if (!RecomputedBase_)
+            throwNotRecomputed();
+        return RecomputedBase_[i];
+    }
+
+    /// throw exception for reading recomputed values outside of a RecomputedStaticData
+    [[noreturn]] static void throwNotRecomputed();
+
+    /// set single-precision element of storage, two of which share each element
+    /// \param i index of single-precision element (as given by Model::dataOffsets())
+    /// \param f value to set
+    void setSingleElement(unsigned i, float f)
+    { std::memcpy(reinterpret_cast<char*>(&element(i / 2)) + (i % 2) * sizeof(float), &f, sizeof(float)); }
+
+    /// \name Readers and writers for CachedDataValue, one for each kind of storage
+    /// @{
+
+    /// \return element of static storage of d
+    static double readElement(const DataPoint& d, unsigned i)
+    { return d.element(i); }
+
+    /// set element of static storage of d
+    static void writeElement(DataPoint& d, unsigned i, double val)
+    { d.element(i) = val; }
+
+    /// \return single-precision element of static storage of d
+    static double readSingleElement(const DataPoint& d, unsigned i)
+    { return d.singleElement(i); }
+
+    /// set single-precision element of static storage of d
+    static void writeSingleElement(DataPoint& d, unsigned i, double val)
+    { d.setSingleElement(i, val); }
+
+    /// \return element of parameter-dependent storage of d
+    static double readDynamicElement(const DataPoint& d, unsigned i)
+    { return d.dynamicElement(i); }
+
+    /// set element of parameter-dependent storage of d
+    static void writeDynamicElement(DataPoint& d, unsigned i, double val)
+    { d.dynamicElement(i) = val; }
+
+    /// \return recomputed element of d
+    static double readRecomputedElement(const DataPoint& d, unsigned i)
+    { return d.recomputedElement(i); }
+
+    /// set recomputed element of d
+    static void writeRecomputedElement(DataPoint& d, unsigned i, double val)
+    { d.recomputedElement(i) = val; }
+
+    /// @}
+
     /// raw pointer to owning DataSet
     DataSet* DataSet_;
 
-    /// Data storage for all DataAccessors
-    /// first index is for the DataAccessor
-    /// second index is for the symmeterization state (as known by the DataAccessor)
-    /// third index is internal to the DataAccessor
-    std::vector<std::vector<std::vector<double> > > Data_;
+    /// Contiguous data storage for all DataAccessors, static data
+    /// first, followed by parameter-dependent data.
+    /// The row for a DataAccessor and symmetrization index starts at
+    /// Model::dataOffset(DataAccessor index, symmetrization index);
+    /// positions within the row are internal to the DataAccessor
+    /// Empty for points stored in the columns of a column-major DataSet.
+    std::vector<double> Data_;
+
+    /// pointer to first element of static storage (in Data_ or in DataSet's columns)
+    double* Base_;
+
+    /// distance between consecutive elements of static storage
+    size_t Stride_;
+
+    /// pointer to first element of parameter-dependent storage (in Data_ or in DataSet's columns)
+    double* DynamicBase_;
+
+    /// distance between consecutive elements of parameter-dependent storage
+    size_t DynamicStride_;
+
+    /// pointer to values of static data recomputed rather than stored,
+    /// held by a RecomputedStaticData; nullptr outside of one
+    double* RecomputedBase_;
 
 };
 
@@ -112,6 +244,58 @@ private:
 /// \brief stl vector of DataPoint's
 using DataPointVector = std::vector<DataPoint>;
 
+/// \typedef DataPointBlock
+/// \brief raw pointers to a block of DataPoint's evaluated together,
+/// one node of the decay tree at a time (see Model::amplitudes)
+using DataPointBlock = std::vector<DataPoint*>;
+
+/// \class RecomputedStaticData
+/// \brief Recomputes the static data that are not stored (see StoragePolicy)
+/// for a block of data points, and holds them for as long as it exists.
+/// Values are recomputed once, on construction; data points already holding
+/// recomputed values are left alone, so that scopes can be nested.
+/// \ingroup Data
+class RecomputedStaticData
+{
+public:
+
+    /// Constructor
+    /// \param B block of data points to recompute static data for
+    /// \param sm StatusManager to update
+    RecomputedStaticData(const DataPointBlock& B, StatusManager& sm)
+    { recompute(B, sm); }
+
+    /// Constructor
+    /// \param d data point to recompute static data for
+    /// \param sm StatusManager to update
+    RecomputedStaticData(DataPoint& d, StatusManager& sm);
+
+    /// Destructor; releases recomputed values
+    ~RecomputedStaticData()
+    { release(); }
+
+    /// copy constructor (deleted)
+    RecomputedStaticData(const RecomputedStaticData&) = delete;
+
+    /// copy assignment operator (deleted)
+    RecomputedStaticData& operator=(const RecomputedStaticData&) = delete;
+
+private:
+
+    /// recompute static data for data points not yet holding recomputed values
+    void recompute(const DataPointBlock& B, StatusManager& sm);
+
+    /// point data points back at no storage
+    void release();
+
+    /// data points recomputed for
+    DataPointBlock Points_;
+
+    /// recomputed values, data point after data point
+    std::vector<double> Values_;
+
+};
+
 }
 
 #endif
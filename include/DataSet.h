@@ -26,16 +26,41 @@
 #include "FourVector.h"
 #include "ReportsModel.h"
 
+#include <atomic>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace yap {
 
+class CachedDataValue;
+class ComponentAmplitudes;
+class MappedFile;
 class Model;
+class ThreadPool;
+
+/// \enum DataLayout
+/// \brief memory layout of the data stored in a DataSet
+/// \ingroup Data
+enum DataLayout {
+    /// one contiguous buffer per DataPoint
+    kRowMajor,
+    /// one contiguous column over all DataPoints
+    /// per element of each CachedDataValue and symmetrization
+    kColumnMajor
+};
 
 /// \class DataSet
 /// \brief Class holding a set of DataPoint objects.
 /// \author Johannes Rauch, Daniel Greenwald
 /// \ingroup Data
+///
+/// For kColumnMajor, the static columns are shared between copies
+/// and subsets of a data set; they are copied only before points are
+/// added to, or final-state momenta set in, a data set sharing them.
+/// Parameter-dependent columns belong to each data set.
+/// For kRowMajor, each data point owns its data, so copies and subsets
+/// copy the data points.
 class DataSet :
     public DataPartitionBlock,
     public ReportsModel
@@ -43,7 +68,17 @@ class DataSet :
 public:
 
     /// Constructor
-    DataSet(const Model& m);
+    /// \param m Model to which the data set belongs
+    /// \param layout memory layout of the data
+    DataSet(const Model& m, DataLayout layout = kRowMajor);
+
+    /// Constructor from a file written by #write: the data set is
+    /// column major, with its static columns memory mapped from the
+    /// file and read in place (they are read only).
+    /// Adding points copies them into anonymous memory.
+    /// \param m Model to which the data set belongs; its layout must match the file's
+    /// \param filename name of file to map
+    DataSet(const Model& m, const std::string& filename);
 
     /// Copy constructor
     DataSet(const DataSet& other);
@@ -51,6 +86,9 @@ public:
     /// Move constructor
     DataSet(DataSet&& other);
 
+    /// Destructor
+    ~DataSet();
+
     /// Copy assignment operator
     DataSet& operator=(const DataSet& other);
 
@@ -74,6 +112,24 @@ public:
     /// \param P vector of four momenta
     void add(const std::vector<FourVector<double> >& P);
 
+    /// Add data points in bulk: static data are calculated accessor by
+    /// accessor over blocks of data points, with blocks divided between threads.
+    /// Afterwards the set's statuses mark stored static data calculated and
+    /// all parameter-dependent data uncalculated.
+    /// If calculation throws, the points added are removed again.
+    /// \param P four momenta of final-state particles of all data points, one data point after another
+    /// \param n_threads number of threads to use; if 0, use the hardware concurrency
+    void addPoints(const std::vector<FourVector<double> >& P, unsigned n_threads = 0);
+
+    /// Add data points in bulk, as above, on the threads of a ThreadPool, without
+    /// creating new threads. Each worker takes an equal share of the points and keeps
+    /// its statuses in its partition, which must belong to a data set of the same model;
+    /// partitions over this data set must be created anew afterwards.
+    /// If calculation throws, the points added are removed again.
+    /// \param P four momenta of final-state particles of all data points, one data point after another
+    /// \param pool ThreadPool to calculate on
+    void addPoints(const std::vector<FourVector<double> >& P, ThreadPool& pool);
+
     /// \return iterator to front of set
     const DataIterator& begin() const override
     { return const_cast<DataSet*>(this)->setBegin(const_cast<DataPointVector*>(&DataPoints_)->begin()); }
@@ -99,8 +155,7 @@ public:
     { return DataPoints_; }
 
     /// reserve storage space
-    void reserve(size_t n)
-    { DataPoints_.reserve(n); }
+    void reserve(size_t n);
 
     /// call shrink to fit on DataPoints_
     void shrink_to_fit()
@@ -109,12 +164,75 @@ public:
     const Model* model() const
     { return Model_; }
 
+    /// \return memory layout of data
+    DataLayout layout() const
+    { return Layout_; }
+
+    /// \return generation of the data points' contents, unique among all
+    /// data sets and renewed whenever points are added or their
+    /// final-state momenta are set; results calculated over a data set
+    /// can be cached by its generation
+    unsigned long generation() const
+    { return Generation_; }
+
+    /// \return pointer to the column holding an element of a
+    /// CachedDataValue for all data points; only available for kColumnMajor,
+    /// and for static values not for subsets. Static columns may be shared
+    /// with other data sets and must not be written to.
+    /// \param cdv CachedDataValue to get column of
+    /// \param index index of element within cached value
+    /// \param sym_index index of symmetrization
+    double* column(const CachedDataValue& cdv, unsigned index, unsigned sym_index);
+
+    /// \return pointer to the column holding an element of a
+    /// CachedDataValue for all data points; only available for kColumnMajor,
+    /// and for static values not for subsets
+    /// \param cdv CachedDataValue to get column of
+    /// \param index index of element within cached value
+    /// \param sym_index index of symmetrization
+    const double* column(const CachedDataValue& cdv, unsigned index, unsigned sym_index) const
+    { return const_cast<DataSet*>(this)->column(cdv, index, sym_index); }
+
+    /// Write to a versioned binary file: a header describing the
+    /// model's DataAccessor layout, followed by one page-aligned
+    /// column per element of each static CachedDataValue and symmetrization.
+    /// \param filename name of file to write to
+    void write(const std::string& filename) const;
+
+    /// \return whether static columns are memory mapped from a file
+    bool mapped() const
+    { return (bool)Mapping_; }
+
+    /// \return data set of the data points at the given indices, which
+    /// may repeat (e.g. for bootstrap resampling), with its own
+    /// parameter-dependent data, which are not yet calculated.
+    /// For kColumnMajor, it holds only the indices into the static
+    /// columns of this data set, which it shares; for kRowMajor, it
+    /// holds copies of the data points.
+    /// \param indices indices of data points in this data set
+    DataSet subset(const std::vector<size_t>& indices) const;
+
+    /// \return data set in which each data point appears as many
+    /// times as given, e.g. 0 or 1 to select a fold for cross-validation;
+    /// see #subset
+    /// \param multiplicities number of times each data point appears
+    DataSet resample(const std::vector<unsigned>& multiplicities) const;
+
     /// equality operator
     friend bool operator==(const DataSet& lhs, const DataSet& rhs);
 
     /// grant friend status to DataPartitionBase to access non-const points()
     friend DataPartitionBase;
 
+    /// grant friend status to DataPartitionStream to read into columns
+    friend class DataPartitionStream;
+
+    /// grant friend status to DataPoint to detach static columns
+    friend DataPoint;
+
+    /// grant friend status to Model to cache ComponentAmplitudes
+    friend class Model;
+
 protected:
 
     /// non-const access to DataPoints_
@@ -124,14 +242,102 @@ protected:
 private:
 
     /// sets this as owner of all its data points
+    /// and points them at their columns for kColumnMajor
     void assertDataPointOwnership();
 
+    /// add data points in bulk, see public addPoints
+    /// \param P four momenta of final-state particles of all data points
+    /// \param pool ThreadPool to calculate on; if null, one is made for the call
+    /// \param n_threads number of threads of pool, or to make a pool with (0 for the hardware concurrency)
+    void addPoints(const std::vector<FourVector<double> >& P, ThreadPool* pool, unsigned n_threads);
+
+    /// leave a moved-from data set without points or columns
+    void releaseColumns();
+
+    /// copy points of another data set, whose columns have been copied
+    void copyPoints(const DataSet& other);
+
+    /// \return whether static columns have never been shared with another data
+    /// set or a mapped file, and hold the data points in order
+    bool staticColumnsUnique() const
+    { return !Mapping_ and Indices_.empty() and !StaticColumnsShared_; }
+
+    /// mark static columns as shared, before handing them to another data set
+    void shareStaticColumns() const
+    { if (StaticColumns_) StaticColumnsShared_ = true; }
+
+    /// grow columns to hold at least n data points;
+    /// copies static columns not unique to this data set
+    void reserveColumns(size_t n);
+
+    /// give the data set a new generation
+    void renewGeneration();
+
+    /// count data set with model, whose data layout it uses
+    /// \param m Model to count with, leaving the current one
+    void setModel(const Model* m);
+
+    /// copy static columns not unique to this data set (kColumnMajor only)
+    void detachStaticColumns()
+    { if (Layout_ == kColumnMajor) reserveColumns(DataPoints_.size()); }
+
     /// vector of data points contained in set
     DataPointVector DataPoints_;
 
     /// Associated model
     const Model* Model_;
 
+    /// count of data sets of Model_, shared with it; never reached through
+    /// Model_, since a data set may outlive its model
+    std::shared_ptr<std::atomic<unsigned> > NDataSets_;
+
+    /// memory layout of data
+    DataLayout Layout_;
+
+    /// column-major storage of parameter-dependent data for all data points (kColumnMajor only):
+    /// element i of data point j is at [i * ColumnCapacity_ + j]
+    std::vector<double> Columns_;
+
+    /// number of data points each column of Columns_ can hold
+    size_t ColumnCapacity_;
+
+    /// column-major storage of static data (kColumnMajor only), possibly shared
+    /// with other data sets: element i of data point j is at
+    /// StaticColumnData_[i * StaticColumnCapacity_ + j] (or + Indices_[j])
+    std::shared_ptr<std::vector<double> > StaticColumns_;
+
+    /// whether StaticColumns_ have been handed to another data set; set
+    /// by whichever data set shares them and never unset while they are
+    /// held, so copies of a data set in several threads agree without
+    /// relying on the reference count
+    mutable std::atomic<bool> StaticColumnsShared_;
+
+    /// file from which static columns are mapped, if any
+    std::shared_ptr<MappedFile> Mapping_;
+
+    /// pointer to first static column (inside StaticColumns_ or Mapping_)
+    double* StaticColumnData_;
+
+    /// number of data points each static column can hold
+    size_t StaticColumnCapacity_;
+
+    /// indices of data points in the static columns, for subsets; empty otherwise
+    std::vector<size_t> Indices_;
+
+    /// generation of contents, see #generation
+    unsigned long Generation_;
+
+    /// ComponentAmplitudes calculated over the data set by its model,
+    /// see Model::setUseComponentAmplitudes
+    std::shared_ptr<ComponentAmplitudes> ComponentAmplitudes_;
+
+    /// generation of contents ComponentAmplitudes_ were calculated for
+    unsigned long ComponentAmplitudesGeneration_;
+
+    /// position in the model's ParameterChangeLog up to which changes
+    /// are accounted for in ComponentAmplitudes_
+    size_t ComponentAmplitudesLogPosition_;
+
 };
 
 }
@@ -24,6 +24,7 @@
 #include "AmplitudeComponent.h"
 #include "Constants.h"
 #include "DataAccessor.h"
+#include "DataPoint.h"
 #include "Parameter.h"
 #include "Particle.h"
 #include "SpinAmplitude.h"
@@ -83,6 +84,23 @@ public:
     virtual std::complex<double> amplitude(DataPoint& d, const std::shared_ptr<ParticleCombination>& pc,
                                            int two_m, StatusManager& sm) const;
 
+    /// Calculate complex amplitudes for all spin projections of the decaying particle
+    /// in one traversal, sharing daughter amplitudes between spin projections
+    /// \return vector of amplitudes indexed by spin_projection_index
+    /// \param d DataPoint to calculate with
+    /// \param pc (shared_ptr to) ParticleCombination to calculate for
+    /// \param sm StatusManager to update
+    std::vector<std::complex<double> > amplitudes(DataPoint& d, const std::shared_ptr<ParticleCombination>& pc,
+                                                  StatusManager& sm) const;
+
+    /// Calculate and cache fixed and total amplitudes for all points of a block,
+    /// in loops over the block, for each symmetrization whose amplitudes are uncalculated.
+    /// The daughters' amplitudes and the decaying particle's Blatt-Weisskopf
+    /// factors must already be calculated for the block
+    /// \param B block of data points to calculate for
+    /// \param sm StatusManager to update, shared by all points of the block
+    void calculate(const DataPointBlock& B, StatusManager& sm) const;
+
     /// check consistency of object
     virtual bool consistent() const override;
 
@@ -154,14 +172,39 @@ protected:
 
 private:
 
+    /// Calculate complex amplitude for one spin projection
+    /// \param d DataPoint to calculate with
+    /// \param pc (shared_ptr to) ParticleCombination to calculate for
+    /// \param i_m spin_projection_index of the spin projection to calculate for
+    /// \param symIndex symmetrization index of pc
+    /// \param D amplitudes of daughters for all their spin projections, filled on first use
+    /// \param sm StatusManager to update
+    std::complex<double> amplitude(DataPoint& d, const std::shared_ptr<ParticleCombination>& pc, unsigned i_m, unsigned symIndex,
+                                   std::vector<std::vector<std::complex<double> > >& D, StatusManager& sm) const;
+
     /// daughters of the decay
     ParticleVector Daughters_;
 
     /// Map of SpinAmplitude (by shared_ptr) to AmplitudePairMap
     map_type Amplitudes_;
 
-    /// Map of spin projection to total amplitude for that spin projection
-    std::map<int, std::shared_ptr<ComplexCachedDataValue> > TotalAmplitudes_;
+    /// \struct ProjectionTerm
+    /// \brief SpinAmplitude and AmplitudePair contributing to one spin projection
+    struct ProjectionTerm {
+        /// SpinAmplitude
+        const SpinAmplitude* SpinAmp;
+
+        /// AmplitudePair in Amplitudes_
+        const AmplitudePair* Amplitudes;
+    };
+
+    /// Terms contributing to each spin projection,
+    /// indexed by spin_projection_index
+    std::vector<std::vector<ProjectionTerm> > ProjectionTerms_;
+
+    /// Total amplitude for each spin projection,
+    /// indexed by spin_projection_index
+    std::vector<std::shared_ptr<ComplexCachedDataValue> > TotalAmplitudes_;
 
     /// raw pointer owning DecayingParticle
     DecayingParticle* DecayingParticle_;
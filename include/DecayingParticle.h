@@ -76,6 +76,20 @@ public:
     /// \param sm StatusManager to update
     virtual std::complex<double> amplitude(DataPoint& d, const std::shared_ptr<ParticleCombination>& pc, int two_m, StatusManager& sm) const override;
 
+    /// Calculate complex amplitudes for all spin projections in one traversal of the decay tree
+    /// \return vector of amplitudes indexed by spin_projection_index
+    /// \param d DataPoint to calculate with
+    /// \param pc (shared_ptr to) ParticleCombination to calculate for
+    /// \param sm StatusManager to update
+    virtual std::vector<std::complex<double> > amplitudes(DataPoint& d, const std::shared_ptr<ParticleCombination>& pc, StatusManager& sm) const override;
+
+    /// Calculate and cache amplitudes for all points of a block: first the
+    /// Blatt-Weisskopf factors, then the channels, then the sums over channels.
+    /// The daughters' amplitudes must already be calculated for the block
+    /// \param B block of data points to calculate for
+    /// \param sm StatusManager to update, shared by all points of the block
+    virtual void calculate(const DataPointBlock& B, StatusManager& sm) const;
+
     /// Check consistency of object
     virtual bool consistent() const override;
 
@@ -118,7 +132,7 @@ public:
     { return Channels_.at(i); }
 
     /// \return Radial size [GeV^-1]
-    std::shared_ptr<RealParameter> radialSize()
+    const std::shared_ptr<RealParameter>& radialSize()
     { return RadialSize_; }
 
     /// @}
@@ -167,9 +181,9 @@ private:
     /// Radial size parameter [GeV^-1]
     std::shared_ptr<RealParameter> RadialSize_;
 
-    /// Cached amplitudes for each spin projection
-    /// key = 2 * spin projection
-    std::map<int, std::shared_ptr<ComplexCachedDataValue> > Amplitudes_;
+    /// Cached amplitudes for each spin projection,
+    /// indexed by spin_projection_index
+    std::vector<std::shared_ptr<ComplexCachedDataValue> > Amplitudes_;
 
 };
 
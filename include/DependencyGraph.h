@@ -0,0 +1,155 @@
+/*  YAP - Yet another PWA toolkit
+    Copyright 2015, Technische Universitaet Muenchen,
+    Authors: Daniel Greenwald, Johannes Rauch
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// \file
+
+#ifndef yap_DependencyGraph_h
+#define yap_DependencyGraph_h
+
+#include "DataAccessor.h"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace yap {
+
+class ParameterBase;
+class ParameterChangeLog;
+
+/// \class DependencyGraph
+/// \brief Flattened graph of dependencies between the cached values of all DataAccessor's
+/// \author Johannes Rauch, Daniel Greenwald
+/// \ingroup Cache
+///
+/// Each node is a status slot (DataAccessor, CachedDataValue,
+/// symmetrization index). Nodes are sorted topologically, so that every
+/// node comes after the nodes it depends on, and dependencies are stored
+/// as integer edges. This lets StatusManager::updateCalculationStatuses
+/// propagate changes in a single linear pass.
+///
+/// Each parameter is indexed to the CachedDataValue's depending on it,
+/// and records its changes in a ParameterChangeLog, so that only
+/// parameters changed since the last update need to be checked.
+class DependencyGraph
+{
+public:
+
+    /// \struct Node
+    /// \brief Status slot of a CachedDataValue for one symmetrization index
+    struct Node {
+        /// index of DataAccessor
+        unsigned DataAccessorIndex;
+
+        /// index of CachedDataValue within DataAccessor
+        unsigned CachedDataValueIndex;
+
+        /// symmetrization index
+        unsigned SymmetrizationIndex;
+
+        /// index of CachedDataValue within graph
+        unsigned ValueIndex;
+    };
+
+    /// Default constructor, making an empty graph
+    DependencyGraph() = default;
+
+    /// Constructor, compiling graph
+    /// \param sDA DataAccessorSet whose CachedDataValue's to build graph of;
+    /// DataAccessor indices must be contiguous
+    /// \param log ParameterChangeLog for parameters to record their changes in
+    DependencyGraph(const DataAccessorSet& sDA, std::shared_ptr<ParameterChangeLog> log);
+
+    /// \return nodes, sorted topologically
+    const std::vector<Node>& nodes() const
+    { return Nodes_; }
+
+    /// \return pointer to first index of nodes node n depends on
+    /// \param n index of node
+    const unsigned* dependenciesBegin(size_t n) const
+    { return Edges_.data() + EdgeOffsets_[n]; }
+
+    /// \return pointer past last index of nodes node n depends on
+    /// \param n index of node
+    const unsigned* dependenciesEnd(size_t n) const
+    { return Edges_.data() + EdgeOffsets_[n + 1]; }
+
+    /// \return number of CachedDataValue's in graph
+    size_t nCachedDataValues() const
+    { return NCachedDataValues_; }
+
+    /// \return parameters CachedDataValue's depend on
+    const std::vector<ParameterBase*>& parameters() const
+    { return Parameters_; }
+
+    /// \return index of parameter in graph, or -1 if not in graph
+    /// \param p parameter
+    int parameterIndex(const ParameterBase* p) const
+    {
+        auto it = ParameterIndices_.find(p);
+        return it == ParameterIndices_.end() ? -1 : (int)it->second;
+    }
+
+    /// \return pointer to first index of CachedDataValue's depending on parameter p
+    /// \param p index of parameter in graph
+    const unsigned* dependentsBegin(size_t p) const
+    { return Dependents_.data() + DependentOffsets_[p]; }
+
+    /// \return pointer past last index of CachedDataValue's depending on parameter p
+    /// \param p index of parameter in graph
+    const unsigned* dependentsEnd(size_t p) const
+    { return Dependents_.data() + DependentOffsets_[p + 1]; }
+
+    /// \return ParameterChangeLog parameters record their changes in
+    const std::shared_ptr<ParameterChangeLog>& changeLog() const
+    { return ChangeLog_; }
+
+private:
+
+    /// nodes, sorted topologically
+    std::vector<Node> Nodes_;
+
+    /// offsets into Edges_ by node, with one more entry for the end
+    std::vector<unsigned> EdgeOffsets_;
+
+    /// indices of nodes depended on
+    std::vector<unsigned> Edges_;
+
+    /// number of CachedDataValue's
+    size_t NCachedDataValues_ = 0;
+
+    /// parameters depended on
+    std::vector<ParameterBase*> Parameters_;
+
+    /// index of parameters in Parameters_
+    std::unordered_map<const ParameterBase*, unsigned> ParameterIndices_;
+
+    /// offsets into Dependents_ by parameter, with one more entry for the end
+    std::vector<unsigned> DependentOffsets_;
+
+    /// indices of CachedDataValue's depending on parameters
+    std::vector<unsigned> Dependents_;
+
+    /// log of parameter changes
+    std::shared_ptr<ParameterChangeLog> ChangeLog_;
+
+};
+
+}
+
+#endif
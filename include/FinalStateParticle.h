@@ -61,6 +61,12 @@ public:
     virtual std::complex<double> amplitude(DataPoint&, const std::shared_ptr<ParticleCombination>&, int, StatusManager&) const override
     { return Complex_1; }
 
+    /// Calculate complex amplitudes for all spin projections.
+    /// All parameters are ignored.
+    /// \return vector of 1 + 0i for each spin projection
+    virtual std::vector<std::complex<double> > amplitudes(DataPoint&, const std::shared_ptr<ParticleCombination>&, StatusManager&) const override
+    { return std::vector<std::complex<double> >(quantumNumbers().twoJ() + 1, Complex_1); }
+
     /// Check consistency
     virtual bool consistent() const override;
 
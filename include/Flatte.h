@@ -64,6 +64,12 @@ public:
     /// \param sm StatusManager to update
     virtual std::complex<double> amplitude(DataPoint& d, const std::shared_ptr<ParticleCombination>& pc, StatusManager& sm) const override;
 
+    /// Calculate and cache width terms, then amplitudes,
+    /// for all points of a block
+    /// \param B block of data points to calculate for
+    /// \param sm StatusManager to update, shared by all points of the block
+    virtual void calculate(const DataPointBlock& B, StatusManager& sm) const override;
+
     /// Add FlatteChannel
     void addChannel(std::shared_ptr<RealParameter> coupling, std::shared_ptr<RealParameter> mass);
 
@@ -82,6 +88,16 @@ public:
 
 protected:
 
+    /// Calculate complex amplitude from the cached width term, without caching
+    /// \param d DataPoint to calculate with
+    /// \param pc (shared_ptr to) ParticleCombination to calculate for
+    virtual std::complex<double> calc(const DataPoint& d, const std::shared_ptr<ParticleCombination>& pc) const override;
+
+    /// \return width term, without caching
+    /// \param d DataPoint to calculate with
+    /// \param pc (shared_ptr to) ParticleCombination to calculate for
+    std::complex<double> widthTerm(const DataPoint& d, const std::shared_ptr<ParticleCombination>& pc) const;
+
     /// borrow dependencies from model
     virtual void setDependenciesFromModel() override;
 
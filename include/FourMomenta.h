@@ -55,6 +55,11 @@ public:
     /// \param sm StatusManager to update
     virtual void calculate(DataPoint& d, StatusManager& sm) const override;
 
+    /// Set policy for storing values: final-state momenta are the input
+    /// all other data are calculated from, so only kStore is allowed
+    /// \param p StoragePolicy to follow
+    virtual void setStoragePolicy(StoragePolicy p) override;
+
     /// \name Getters
     /// @{
 
@@ -87,7 +92,7 @@ public:
     { return M_; }
 
     /// \return masses (const)
-    std::shared_ptr<RealCachedDataValue> mass() const
+    const std::shared_ptr<RealCachedDataValue>& mass() const
     { return M_; }
 
     /// \return momentum
@@ -95,7 +100,7 @@ public:
     { return P_; }
 
     /// \return momentum (const)
-    std::shared_ptr<FourVectorCachedDataValue> momentum() const
+    const std::shared_ptr<FourVectorCachedDataValue>& momentum() const
     { return P_; }
 
     /// @}
@@ -112,6 +117,9 @@ public:
     /// grant friend status to DataPoint to call setFourMomenta
     friend class DataPoint;
 
+    /// grant friend status to DataSet to call setFourMomenta
+    friend class DataSet;
+
 protected:
 
     /// set final-state four-momenta
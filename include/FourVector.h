@@ -56,10 +56,26 @@ public:
     using Vector<T, 4>::operator=;
 
     /// \return inner (dot) product for 4-vectors
-    constexpr T operator*(const Vector<T, 4>& B) const override
+    constexpr T operator*(const Vector<T, 4>& B) const
     { return this->front() * B.front() - std::inner_product(this->begin() + 1, this->end(), B.begin() + 1, (T)0); }
 };
 
+/// \return squared magnitude of #FourVector (using Minkowski inner product)
+template <typename T>
+constexpr T norm(const FourVector<T>& V)
+{ return V * V; }
+
+/// \return magnitude of #FourVector (using Minkowski inner product)
+template <typename T>
+constexpr T abs(const FourVector<T>& V)
+{ return sqrt(norm(V)); }
+
+/// \return unit #FourVector (using Minkowski inner product)
+/// \param V FourVector to use for direction of unit vector
+template <typename T>
+FourVector<T> unit(const FourVector<T>& V)
+{ T a = abs(V); return (a == 0) ? V : FourVector<T>((T(1) / a) * V); }
+
 /// \return Spatial #ThreeVector inside #FourVector
 template <typename T>
 constexpr ThreeVector<T> vect(const FourVector<T>& V) noexcept
@@ -23,14 +23,18 @@
 
 #include "Constants.h"
 #include "CoordinateSystem.h"
+#include "LorentzTransformation.h"
 #include "Rotation.h"
 #include "StaticDataAccessor.h"
 #include "ThreeVector.h"
 
+#include <cmath>
+#include <complex>
 #include <memory>
 
 namespace yap {
 
+class ComplexCachedDataValue;
 class RealCachedDataValue;
 class Model;
 class ParticleCombination;
@@ -52,6 +56,10 @@ class StatusManager;
 ///      in the decaying particle's rest frame, the angles are
 ///      - \f$ \cos\theta \equiv \hat{q} \cdot \hat{z} \f$
 ///      - \f$ \cos\phi   \equiv \hat{q} \cdot \hat{x} / \sin\theta \f$
+///
+/// \f$ \cos\theta \f$ and \f$ e^{i\phi} \f$ are stored, calculated directly from
+/// the components of \f$ \hat{q} \f$, for use in Wigner D-functions;
+/// the angles themselves are calculated from them when asked for.
 /// If the decaying particle has 0 momentum or \f$ \hat{p} = \hat{z}_0 \f$
 ///   - \f$ \hat{z} \equiv \hat{z}_0 \f$
 ///   - \f$ \hat{y} \equiv \hat{y}_0 \f$
@@ -71,29 +79,37 @@ public:
     /// \param sm StatusManager to update
     virtual void calculate(DataPoint& d, StatusManager& sm) const override;
 
-    /// get azimuthal angle
+    /// get azimuthal angle, from \f$ e^{i\phi} \f$
     double phi(const DataPoint& d, const std::shared_ptr<ParticleCombination>& pc) const
-    { return Phi_->value(d, symmetrizationIndex(pc)); }
+    { return std::arg(expIPhi(d, pc)); }
 
-    /// access azimuthal angle
-    std::shared_ptr<RealCachedDataValue>& phi()
-    { return Phi_; }
+    /// get polar angle, from \f$ \cos\theta \f$
+    double theta(const DataPoint& d, const std::shared_ptr<ParticleCombination>& pc) const
+    { return std::acos(cosTheta(d, pc)); }
 
-    /// access azimuthal angle (const)
-    const std::shared_ptr<RealCachedDataValue>& phi() const
-    { return Phi_; }
+    /// get cosine of polar angle
+    double cosTheta(const DataPoint& d, const std::shared_ptr<ParticleCombination>& pc) const
+    { return CosTheta_->value(d, symmetrizationIndex(pc)); }
 
-    /// get polar angle
-    double theta(const DataPoint& d, const std::shared_ptr<ParticleCombination>& pc) const
-    { return Theta_->value(d, symmetrizationIndex(pc)); }
+    /// access cosine of polar angle
+    std::shared_ptr<RealCachedDataValue>& cosTheta()
+    { return CosTheta_; }
+
+    /// access cosine of polar angle (const)
+    const std::shared_ptr<RealCachedDataValue>& cosTheta() const
+    { return CosTheta_; }
+
+    /// get complex phase of azimuthal angle, \f$ e^{i\phi} \f$
+    std::complex<double> expIPhi(const DataPoint& d, const std::shared_ptr<ParticleCombination>& pc) const
+    { return ExpIPhi_->value(d, symmetrizationIndex(pc)); }
 
-    /// access polar angle
-    std::shared_ptr<RealCachedDataValue>& theta()
-    { return Theta_; }
+    /// access complex phase of azimuthal angle
+    std::shared_ptr<ComplexCachedDataValue>& expIPhi()
+    { return ExpIPhi_; }
 
-    /// access polar angle (const)
-    const std::shared_ptr<RealCachedDataValue>& theta() const
-    { return Theta_; }
+    /// access complex phase of azimuthal angle (const)
+    const std::shared_ptr<ComplexCachedDataValue>& expIPhi() const
+    { return ExpIPhi_; }
 
     virtual std::string data_accessor_type() const override
     {return "HelicityAngles"; }
@@ -105,17 +121,18 @@ protected:
 
     /// recursive helicity-angle calculator that travels down decay trees for all channels
     void calculateAngles(DataPoint& d, const std::shared_ptr<ParticleCombination>& pc,
-                         const CoordinateSystem<double, 3>& C, const FourMatrix<double>& boosts,
+                         const CoordinateSystem<double, 3>& C, const LorentzBoost<double>& boosts,
                          StatusManager& sm) const;
 
     /// override to throw on adding final-state PC
     unsigned addParticleCombination(std::shared_ptr<ParticleCombination> pc) override;
 
-    /// Azimuthal angle
-    std::shared_ptr<RealCachedDataValue> Phi_;
+    /// Cosine of polar angle
+    std::shared_ptr<RealCachedDataValue> CosTheta_;
 
-    /// Polar angle
-    std::shared_ptr<RealCachedDataValue> Theta_;
+    /// Complex phase of azimuthal angle, \f$ e^{i\phi} \f$,
+    /// calculated without inverse trigonometric functions
+    std::shared_ptr<ComplexCachedDataValue> ExpIPhi_;
 
 };
 
@@ -32,6 +32,7 @@ namespace yap {
 
 class DataPoint;
 class ParticleCombination;
+class StatusManager;
 
 /// \class HelicitySpinAmplitude
 /// \brief Class implementing a canonical spin amplitude, i.e. with defined relative angular momentum.
@@ -50,6 +51,12 @@ public:
     virtual std::complex<double> calc(int two_M, int two_m1, int two_m2,
                                       const DataPoint& d, const std::shared_ptr<ParticleCombination>& pc) const override;
 
+    /// Calculates the spin amplitudes for all (M, m1, m2) of a
+    /// particle combination from one evaluation of the d-matrix
+    /// \param d DataPoint to calculate into
+    /// \param sm StatusManager to update
+    virtual void calculate(DataPoint& d, StatusManager& sm) const override;
+
     /// \return "helicity formalism"
     virtual std::string formalism() const override
     { return "helicity formalism"; }
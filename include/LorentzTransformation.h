@@ -26,6 +26,7 @@
 #include "ThreeVector.h"
 
 #include <algorithm>
+#include <vector>
 
 namespace yap {
 
@@ -40,22 +41,93 @@ FourMatrix<T> lorentzTransformation(const ThreeMatrix<T>& R)
     return L;
 }
 
-/// \return a 4D Lorentz-transformation matrix for a pure boost
-/// \param V #FourVector of four-momentum defining boost
+/// \class LorentzBoost
+/// \brief Pure Lorentz boost, stored as boost vector and gamma factor
+/// \author Daniel Greenwald
+/// \ingroup VectorAlgebra
+///
+/// Applying a LorentzBoost to a #FourVector costs a handful of
+/// multiplications, instead of the 4x4 matrix product of a
+/// Lorentz-transformation matrix.
 template <typename T>
-FourMatrix<T> lorentzTransformation(const FourVector<T>& V)
+class LorentzBoost
 {
-    auto gamma = V[0] / abs(V); // E / m
-    auto b = FourVector<T>((gamma + 1), gamma * vect(V) / V[0]) / sqrt(gamma + 1); // vect(V)/V[0] = beta
+public:
+
+    /// Default constructor: the identity
+    LorentzBoost() : Beta_({0, 0, 0}), Gamma_(1), GammaFactor_(T(1) / 2) {}
+
+    /// Constructor
+    /// \param beta boost vector
+    /// \param gamma gamma factor, \f$ 1 / \sqrt{1 - \beta^2} \f$
+    LorentzBoost(const ThreeVector<T>& beta, T gamma) :
+        Beta_(beta), Gamma_(gamma), GammaFactor_(gamma * gamma / (gamma + 1)) {}
+
+    /// \return boost vector
+    const ThreeVector<T>& beta() const
+    { return Beta_; }
+
+    /// \return gamma factor
+    T gamma() const
+    { return Gamma_; }
+
+    /// \return \f$ \gamma^2 / (\gamma + 1) \f$
+    T gammaFactor() const
+    { return GammaFactor_; }
+
+private:
+
+    /// boost vector
+    ThreeVector<T> Beta_;
+
+    /// gamma factor
+    T Gamma_;
+
+    /// gamma^2 / (gamma + 1), the coefficient of the spatial part
+    T GammaFactor_;
+
+};
+
+/// \return LorentzBoost with the velocity of a four-momentum;
+/// gives the same transformation as #lorentzTransformation(const FourVector<T>&)
+/// \param V #FourVector of four-momentum defining boost
+template <typename T>
+LorentzBoost<T> lorentzBoost(const FourVector<T>& V)
+{ return LorentzBoost<T>(vect(V) / V[0], V[0] / abs(V)); }
+
+/// \return LorentzBoost for a boost vector
+/// \param beta #ThreeVector of boost velocity
+template <typename T>
+LorentzBoost<T> lorentzBoost(const ThreeVector<T>& beta)
+{ return LorentzBoost<T>(beta, T(1) / sqrt(T(1) - norm(beta))); }
 
-    return diagonalMatrix<T, 4>({ -1, 1, 1, 1}) + outer(b, b);
+/// \return a 4D Lorentz-transformation matrix for a pure boost
+/// \param B #LorentzBoost defining boost
+template <typename T>
+FourMatrix<T> lorentzTransformation(const LorentzBoost<T>& B)
+{
+    FourMatrix<T> L;
+    L[0][0] = B.gamma();
+    for (unsigned i = 0; i < 3; ++i) {
+        L[0][i + 1] = L[i + 1][0] = B.gamma() * B.beta()[i];
+        for (unsigned j = 0; j < 3; ++j)
+            L[i + 1][j + 1] = (i == j ? T(1) : T(0)) + B.gammaFactor() * B.beta()[i] * B.beta()[j];
+    }
+    return L;
 }
 
+/// \return a 4D Lorentz-transformation matrix for a pure boost,
+/// built element by element without intermediate matrices
+/// \param V #FourVector of four-momentum defining boost
+template <typename T>
+FourMatrix<T> lorentzTransformation(const FourVector<T>& V)
+{ return lorentzTransformation(lorentzBoost(V)); }
+
 /// \return a 4D Lorentz-transformation matrix for a pure boost
 /// \param V #ThreeVector defining boost
 template <typename T>
-constexpr FourMatrix<T> lorentzTransformation(const ThreeVector<T>& V)
-{ return lorentzTransformation<T>(FourVector<T>(T(1), V)); }
+FourMatrix<T> lorentzTransformation(const ThreeVector<T>& V)
+{ return lorentzTransformation(lorentzBoost(V)); }
 
 /// \return a 4D Lorentz-transformation matrix for a pure boost
 /// \param fourVecs the sum of these define the boost
@@ -63,33 +135,127 @@ template <typename T>
 constexpr FourMatrix<T> lorentzTransformation(const std::vector<FourVector<T> >& fourVecs)
 { return lorentzTransformation(std::accumulate(fourVecs.begin(), fourVecs.end(), FourVector<T>({0, 0, 0, 0}))); }
 
+/// \return a 4D Lorentz-transformation matrix for a rotation followed by a boost,
+/// \f$ \Lambda_B \cdot R \f$, built in one pass over R
+/// \param R #ThreeMatrix defining rotation
+/// \param B #LorentzBoost defining boost
+template <typename T>
+FourMatrix<T> lorentzTransformation(const ThreeMatrix<T>& R, const LorentzBoost<T>& B)
+{
+    const auto& b = B.beta();
+    FourMatrix<T> L;
+    L[0][0] = B.gamma();
+    for (unsigned i = 0; i < 3; ++i)
+        L[i + 1][0] = B.gamma() * b[i];
+    for (unsigned j = 0; j < 3; ++j) {
+        // beta * (column j of R)
+        const T u = b[0] * R[0][j] + b[1] * R[1][j] + b[2] * R[2][j];
+        L[0][j + 1] = B.gamma() * u;
+        for (unsigned i = 0; i < 3; ++i)
+            L[i + 1][j + 1] = R[i][j] + B.gammaFactor() * b[i] * u;
+    }
+    return L;
+}
+
+/// \return a 4D Lorentz-transformation matrix for a boost followed by a rotation,
+/// \f$ R \cdot \Lambda_B \f$, built in one pass over R
+/// \param B #LorentzBoost defining boost
+/// \param R #ThreeMatrix defining rotation
+template <typename T>
+FourMatrix<T> lorentzTransformation(const LorentzBoost<T>& B, const ThreeMatrix<T>& R)
+{
+    const auto& b = B.beta();
+    FourMatrix<T> L;
+    L[0][0] = B.gamma();
+    for (unsigned j = 0; j < 3; ++j)
+        L[0][j + 1] = B.gamma() * b[j];
+    for (unsigned i = 0; i < 3; ++i) {
+        // (row i of R) * beta
+        const T u = R[i][0] * b[0] + R[i][1] * b[1] + R[i][2] * b[2];
+        L[i + 1][0] = B.gamma() * u;
+        for (unsigned j = 0; j < 3; ++j)
+            L[i + 1][j + 1] = R[i][j] + B.gammaFactor() * u * b[j];
+    }
+    return L;
+}
+
+/// apply a LorentzBoost to a FourVector:
+/// \f$ E' = \gamma (E + \vec{\beta}\cdot\vec{p}) \f$ and
+/// \f$ \vec{p}' = \vec{p} + (\frac{\gamma^2}{\gamma + 1} \vec{\beta}\cdot\vec{p} + \gamma E) \vec{\beta} \f$
+template <typename T>
+FourVector<T> operator*(const LorentzBoost<T>& B, const FourVector<T>& V)
+{
+    const auto& b = B.beta();
+    const T bp = b[0] * V[1] + b[1] * V[2] + b[2] * V[3];
+    const T f = B.gammaFactor() * bp + B.gamma() * V[0];
+    return FourVector<T>({B.gamma() * (V[0] + bp), V[1] + f * b[0], V[2] + f * b[1], V[3] + f * b[2]});
+}
+
+/// \return spatial components of a boosted FourVector, vect(B * V),
+/// without calculating the boosted energy
+template <typename T>
+ThreeVector<T> boostedVect(const LorentzBoost<T>& B, const FourVector<T>& V)
+{
+    const auto& b = B.beta();
+    const T f = B.gammaFactor() * (b[0] * V[1] + b[1] * V[2] + b[2] * V[3]) + B.gamma() * V[0];
+    return ThreeVector<T>({V[1] + f * b[0], V[2] + f * b[1], V[3] + f * b[2]});
+}
+
+/// apply a LorentzBoost to each of a vector of FourVector's
+template <typename T>
+std::vector<FourVector<T> > operator*(const LorentzBoost<T>& B, const std::vector<FourVector<T> >& V)
+{
+    std::vector<FourVector<T> > result;
+    result.reserve(V.size());
+    for (auto& v : V)
+        result.push_back(B * v);
+    return result;
+}
+
+/// compose two LorentzBoost's; the result is in general not a pure boost
+/// \return 4D Lorentz-transformation matrix for boost B followed by boost A
+template <typename T>
+FourMatrix<T> operator*(const LorentzBoost<T>& A, const LorentzBoost<T>& B)
+{
+    FourMatrix<T> L;
+    // column j of the result is A applied to B applied to the j'th unit vector
+    for (unsigned j = 0; j < 4; ++j) {
+        FourVector<T> e({0, 0, 0, 0});
+        e[j] = 1;
+        const auto col = A * (B * e);
+        for (unsigned i = 0; i < 4; ++i)
+            L[i][j] = col[i];
+    }
+    return L;
+}
+
 /// \return a 4D Lorentz-transformation matrix for a rotation followed by a boost
 /// \param R #ThreeMatrix defining rotation
 /// \param V #FourVector defining boost
 template <typename T>
 constexpr FourMatrix<T> lorentzTransformation(const ThreeMatrix<T>& R, const FourVector<T>& V)
-{ return lorentzTransformation<T>(V) * lorentzTransformation<T>(R); }
+{ return lorentzTransformation(R, lorentzBoost(V)); }
 
 /// \return a 4D Lorentz-transformation matrix for a rotation followed by a boost
 /// \param R #ThreeMatrix defining rotation
 /// \param V #ThreeVector defining boost
 template <typename T>
 constexpr FourMatrix<T> lorentzTransformation(const ThreeMatrix<T>& R, const ThreeVector<T>& V)
-{ return lorentzTransformation<T>(V) * lorentzTransformation<T>(R); }
+{ return lorentzTransformation(R, lorentzBoost(V)); }
 
 /// \return a 4D Lorentz-transformation matrix for a boost followed by a rotation
 /// \param R #ThreeMatrix defining rotation
 /// \param V #FourVector defining boost
 template <typename T>
 constexpr FourMatrix<T> lorentzTransformation(const FourVector<T>& V, const ThreeMatrix<T> R)
-{ return lorentzTransformation<T>(R) * lorentzTransformation<T>(V); }
+{ return lorentzTransformation(lorentzBoost(V), R); }
 
 /// \return a 4D Lorentz-transformation matrix for a boost followed by a rotation
 /// \param R #ThreeMatrix defining rotation
 /// \param V #ThreeVector defining boost
 template <typename T>
 constexpr FourMatrix<T> lorentzTransformation(const ThreeVector<T>& V, const ThreeMatrix<T>& R)
-{ return lorentzTransformation<T>(R) * lorentzTransformation<T>(V); }
+{ return lorentzTransformation(lorentzBoost(V), R); }
 
 }
 #endif
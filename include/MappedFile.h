@@ -0,0 +1,86 @@
+/*  YAP - Yet another PWA toolkit
+    Copyright 2015, Technische Universitaet Muenchen,
+    Authors: Daniel Greenwald, Johannes Rauch
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// \file
+
+#ifndef yap_MappedFile_h
+#define yap_MappedFile_h
+
+#include <cstddef>
+#include <string>
+
+namespace yap {
+
+/// \class MappedFile
+/// \brief Private, copy-on-write memory mapping of a whole file
+/// \author Johannes Rauch, Daniel Greenwald
+/// \ingroup Data
+///
+/// The file is opened read only. Pages are shared with the page cache
+/// until written to, when they are copied into anonymous memory; the
+/// file itself is never changed.
+class MappedFile
+{
+public:
+
+    /// Constructor; maps the whole file
+    /// \param filename name of file to map
+    explicit MappedFile(const std::string& filename);
+
+    /// Destructor; unmaps the file
+    ~MappedFile();
+
+    /// copy constructor (deleted)
+    MappedFile(const MappedFile&) = delete;
+
+    /// copy assignment operator (deleted)
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// \return pointer to beginning of mapping
+    char* data()
+    { return Data_; }
+
+    /// \return pointer to beginning of mapping (const)
+    const char* data() const
+    { return Data_; }
+
+    /// \return size of mapping [bytes]
+    size_t size() const
+    { return Size_; }
+
+    /// make a range of the mapping read only, so that it is never copied
+    /// \param offset beginning of range [bytes], must be a multiple of pageSize()
+    /// \param length length of range [bytes]
+    void protect(size_t offset, size_t length);
+
+    /// \return size of a page of memory [bytes]
+    static size_t pageSize();
+
+private:
+
+    /// pointer to beginning of mapping
+    char* Data_;
+
+    /// size of mapping [bytes]
+    size_t Size_;
+
+};
+
+}
+
+#endif
@@ -23,6 +23,7 @@
 
 #include "AmplitudeComponent.h"
 #include "DataAccessor.h"
+#include "DataPoint.h"
 #include "ParticleFactory.h"
 
 #include <memory>
@@ -40,7 +41,8 @@ class Resonance;
 /// \defgroup MassShapes Mass Shapes
 ///
 /// Inheriting classes (mass shapes) must implement
-/// #AmplitudeComponent's amplitude(...) function.
+/// #AmplitudeComponent's amplitude(...) function
+/// and #calc(...), which calculates without caching.
 
 class MassShape : public AmplitudeComponent, public DataAccessor
 {
@@ -56,6 +58,13 @@ public:
     /// \param sm StatusManager to update
     virtual std::complex<double> amplitude(DataPoint& d, const std::shared_ptr<ParticleCombination>& pc, StatusManager& sm) const = 0;
 
+    /// Calculate and cache amplitudes for all points of a block, for each
+    /// symmetrization whose amplitude is uncalculated. The default
+    /// implementation calls calc(...) for each data point.
+    /// \param B block of data points to calculate for
+    /// \param sm StatusManager to update, shared by all points of the block
+    virtual void calculate(const DataPointBlock& B, StatusManager& sm) const;
+
     /// Set parameters from ParticleTableEntry
     /// Can be overloaded in inheriting classes
     /// \param entry ParticleTableEntry containing information to create mass shape object
@@ -65,6 +74,14 @@ public:
     /// Check consistency of object
     virtual bool consistent() const override;
 
+    /// \return cached dynamic amplitude
+    virtual CachedDataValueSet cachedDataValuesItDependsOn() override
+    { return {T_}; }
+
+    /// access cached dynamic amplitude (const)
+    const std::shared_ptr<ComplexCachedDataValue>& T() const
+    { return T_; }
+
     /// get raw pointer to owning resonance
     Resonance* resonance() const
     { return Resonance_; }
@@ -83,6 +100,12 @@ public:
 
 protected:
 
+    /// Calculate complex amplitude without checking or setting statuses;
+    /// cached values it depends on must already be calculated.
+    /// \param d DataPoint to calculate with
+    /// \param pc (shared_ptr to) ParticleCombination to calculate for
+    virtual std::complex<double> calc(const DataPoint& d, const std::shared_ptr<ParticleCombination>& pc) const = 0;
+
     /// calls setDependenciesFromModel
     virtual void addToModel() override;
 
@@ -102,13 +125,9 @@ protected:
     void replaceResonanceMass(std::shared_ptr<RealParameter> m);
 
     /// access cached dynamic amplitude
-    std::shared_ptr<ComplexCachedDataValue> T()
+    const std::shared_ptr<ComplexCachedDataValue>& T()
     { return T_; }
 
-    /// access cached dynamic amplitude (const)
-    const std::shared_ptr<ComplexCachedDataValue> T() const
-    { return const_cast<MassShape*>(this)->T(); }
-
 private:
 
     /// raw pointer to resonance that owns this mass shape
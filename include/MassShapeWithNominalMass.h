@@ -46,10 +46,10 @@ public:
     virtual void setParameters(const ParticleTableEntry& entry) override;
 
     /// Get mass
-    std::shared_ptr<RealParameter> mass();
+    const std::shared_ptr<RealParameter>& mass();
 
     /// Get mass (const)
-    const std::shared_ptr<RealParameter> mass() const
+    const std::shared_ptr<RealParameter>& mass() const
     { return const_cast<MassShapeWithNominalMass*>(this)->mass(); }
 
     virtual std::string data_accessor_type() const override
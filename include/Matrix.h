@@ -89,24 +89,12 @@ std::string to_string(const Matrix<T, R, C>& M)
 /// zero square matrix
 template <typename T, size_t N>
 SquareMatrix<T, N> zeroMatrix()
-{
-    SquareMatrix<T, N> u;
-    for (size_t i = 0; i < N; ++i)
-        for (size_t j = 0; j < N; ++j)
-            u[i][j] = (T)(0);
-    return u;
-}
+{ return SquareMatrix<T, N>(); }
 
 /// zero matrix
 template <typename T, size_t R, size_t C>
 Matrix<T, R, C> zeroMatrix()
-{
-    Matrix<T, R, C> u;
-    for (size_t r = 0; r < R; ++r)
-        for (size_t c = 0; c < C; ++c)
-            u[r][c] = (T)(0);
-    return u;
-}
+{ return Matrix<T, R, C>(); }
 
 /// unit matrix
 template <typename T, size_t N>
@@ -123,7 +111,7 @@ SquareMatrix<T, N> unitMatrix()
 template <typename T, size_t N>
 SquareMatrix<T, N> diagonalMatrix(std::array<T, N> d)
 {
-    SquareMatrix<T, N> D = zeroMatrix<T, N, N>();
+    SquareMatrix<T, N> D;
     for (size_t i = 0; i < N; ++i)
         D[i][i] = d[i];
     return D;
@@ -148,19 +136,22 @@ constexpr Matrix<T, C, R> operator-(const Matrix<T, R, C>& M)
 /// matrix multiplication
 template <typename T, size_t R, size_t K, size_t C>
 typename std::enable_if < (R != 1) or (C != 1), Matrix<T, R, C> >::type
-operator*(const Matrix<T, R, K> A, const Matrix<T, K, C> B)
+operator*(const Matrix<T, R, K>& A, const Matrix<T, K, C>& B)
 {
-    Matrix<T, R, C> res = zeroMatrix<T, R, C>();
+    Matrix<T, R, C> res;
     for (size_t r = 0; r < R; ++r)
-        for (size_t c = 0; c < C; ++c)
-            for (size_t k = 0; k < K; ++k)
-                res[r][c] += A[r][k] * B[k][c];
+        for (size_t c = 0; c < C; ++c) {
+            T sum = A[r][0] * B[0][c];
+            for (size_t k = 1; k < K; ++k)
+                sum += A[r][k] * B[k][c];
+            res[r][c] = sum;
+        }
     return res;
 }
 
 /// matrix multiplication yielding single value
 template <typename T, size_t K>
-T operator*(const Matrix<T, 1, K> A, const Matrix<T, K, 1> B)
+T operator*(const Matrix<T, 1, K>& A, const Matrix<T, K, 1>& B)
 {
     T res({});
     for (size_t k = 0; k < K; ++k)
@@ -70,7 +70,7 @@ public:
     { return Q2_; }
 
     /// \return Breakup Momentum (const)
-    std::shared_ptr<RealCachedDataValue> breakupMomenta() const
+    const std::shared_ptr<RealCachedDataValue>& breakupMomenta() const
     { return Q2_; }
 
     virtual std::string data_accessor_type() const override
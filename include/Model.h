@@ -24,15 +24,21 @@
 #include "CoordinateSystem.h"
 #include "DataPartition.h"
 #include "DataSet.h"
+#include "DependencyGraph.h"
 #include "FourVector.h"
 #include "ParticleCombinationCache.h"
+#include "StaticDataAccessor.h"
 
+#include <atomic>
 #include <complex>
+#include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace yap {
 
+class ComponentAmplitudes;
 class DecayingParticle;
 class DataPoint;
 class FinalStateParticle;
@@ -42,6 +48,8 @@ class MassAxes;
 class MeasuredBreakupMomenta;
 class SpinAmplitudeCache;
 class StatusManager;
+class ThreadPool;
+class WorkStealingScheduler;
 
 /// \class Model
 /// \brief Class implementing a PWA model
@@ -69,6 +77,16 @@ public:
     /// \param sm StatusManager to update
     std::complex<double> amplitude(DataPoint& d, StatusManager& sm) const;
 
+    /// Calculate amplitudes (summed over all particle combinations and
+    /// spin projections of ISP) for all data points in a partition.
+    /// Data points are evaluated in blocks, one node of the decay tree
+    /// at a time (see DecayingParticle::calculate).
+    /// \param D DataPartition to evaluate over
+    /// \param global StatusManager to reset partition's statuses to
+    /// \param A vector to fill with amplitudes, in order of iteration over D;
+    /// its contents are replaced and its capacity reused
+    void amplitudes(DataPartitionBase& D, const StatusManager& global, std::vector<std::complex<double> >& A) const;
+
     /// \return The sum of the logs of squared amplitudes evaluated over the data partition
     /// \param D pointer to DataPartition to evalue over
     /// \param global StatusManager to reset partition's statuses to
@@ -79,16 +97,48 @@ public:
     /// \param DP DataPartitionVector of partitions to use
     double sumOfLogsOfSquaredAmplitudes(DataSet& DS, DataPartitionVector& DP) const;
 
+    /// Calculate the sum of the logs of the squared amplitudes evaluated over all partitions
+    /// bound to the threads of a ThreadPool, without creating new threads
+    /// \param DS DataSet to evaluate over
+    /// \param pool ThreadPool holding partitions of DS; throws if they belong to another data set
+    double sumOfLogsOfSquaredAmplitudes(DataSet& DS, ThreadPool& pool) const;
+
+    /// Calculate the sum of the logs of the squared amplitudes evaluated over all chunks
+    /// of a data set, dynamically distributed over worker threads
+    /// \param DS DataSet to evaluate over
+    /// \param scheduler WorkStealingScheduler to distribute calculation with
+    double sumOfLogsOfSquaredAmplitudes(DataSet& DS, WorkStealingScheduler& scheduler) const;
+
     /// Calculate the sum of the logs of the squared amplitudes
     /// \param DS DataSet to evaluate over
     double sumOfLogsOfSquaredAmplitudes(DataSet& DS) const;
 
+    /// \return whether sums of logs of squared amplitudes are evaluated from
+    /// ComponentAmplitudes while the model is linear in its free amplitudes
+    bool useComponentAmplitudes() const
+    { return UseComponentAmplitudes_; }
+
+    /// Set whether to evaluate sums of logs of squared amplitudes from
+    /// ComponentAmplitudes while the model is linear in its free
+    /// amplitudes (see #linearInFreeAmplitudes), e.g. for fitting only
+    /// free amplitudes. The components are kept by each data set evaluated
+    /// over, and recalculated only when that data set or a parameter other
+    /// than a free amplitude changes; like its statuses, they are updated
+    /// by evaluating, so a data set must not be evaluated over concurrently.
+    /// \param use whether to use ComponentAmplitudes
+    void setUseComponentAmplitudes(bool use);
+
     /// @}
 
     /// Check consistency of object
     virtual bool consistent() const;
 
-    /// removes expired DataAccessor's, prune's remaining, and assigns them indices
+    /// removes expired DataAccessor's, prune's remaining, assigns them indices,
+    /// and builds the tables of symmetrization indices by ParticleCombination ID,
+    /// the graph of dependencies between cached values,
+    /// and the ordered list of static data accessors;
+    /// then decides which static data accessors to recompute rather than
+    /// store (see StoragePolicy) and builds the table of offsets into DataPoint storage
     void prepareDataAccessors();
 
     /// \name Getters
@@ -103,7 +153,7 @@ public:
     { return FourMomenta_; }
 
     /// \return FourMomenta accessor (const)
-    const std::shared_ptr<FourMomenta> fourMomenta() const
+    const std::shared_ptr<FourMomenta>& fourMomenta() const
     { return FourMomenta_; }
 
     /// \return MeasuredBreakupMomenta accessor
@@ -111,7 +161,7 @@ public:
     { return MeasuredBreakupMomenta_; }
 
     /// \return MeasuredBreakupMomenta accessor (const)
-    const std::shared_ptr<MeasuredBreakupMomenta> measuredBreakupMomenta() const
+    const std::shared_ptr<MeasuredBreakupMomenta>& measuredBreakupMomenta() const
     { return MeasuredBreakupMomenta_; }
 
     /// \return HelicityAngles accessor
@@ -119,7 +169,7 @@ public:
     { return HelicityAngles_; }
 
     /// \return HelicityAngles accessor (const)
-    const std::shared_ptr<HelicityAngles> helicityAngles() const
+    const std::shared_ptr<HelicityAngles>& helicityAngles() const
     { return HelicityAngles_; }
 
     /// \return ParticleCombinationCache
@@ -154,6 +204,52 @@ public:
     const DataAccessorSet dataAccessors() const
     { return DataAccessors_; }
 
+    /// \return offsets of storage rows inside a DataPoint, in order of
+    /// DataAccessor index, then symmetrization index (see #dataOffsetIndices);
+    /// offsets of single-precision rows count floats;
+    /// offsets of parameter-dependent rows count from the end of the static data
+    const std::vector<unsigned>& dataOffsets() const
+    { return DataOffsets_; }
+
+    /// \return index into #dataOffsets of first row of each DataAccessor,
+    /// by DataAccessor index, followed by the total number of rows
+    const std::vector<unsigned>& dataOffsetIndices() const
+    { return DataOffsetIndices_; }
+
+    /// \return offset of storage row inside a DataPoint (see #dataOffsets)
+    /// \param i index of DataAccessor
+    /// \param j symmetrization index
+    unsigned dataOffset(unsigned i, unsigned j) const
+    { return DataOffsets_[DataOffsetIndices_[i] + j]; }
+
+    /// \return number of doubles stored in a DataPoint
+    unsigned dataPointSize() const
+    { return DataPointSize_; }
+
+    /// \return number of doubles of static data stored in a DataPoint;
+    /// they precede the parameter-dependent data
+    unsigned staticDataSize() const
+    { return StaticDataSize_; }
+
+    /// \return index of first double in a DataPoint holding single-precision
+    /// values (two per double); equals staticDataSize() if there are none
+    unsigned singlePrecisionOffset() const
+    { return SinglePrecisionOffset_; }
+
+    /// \return number of doubles recomputed for a DataPoint rather than stored in it
+    unsigned recomputedDataSize() const
+    { return RecomputedDataSize_; }
+
+    /// \return static data accessors, ordered such that each comes after
+    /// those it depends on; built by prepareDataAccessors()
+    const std::vector<StaticDataAccessor*>& staticDataAccessors() const
+    { return StaticDataAccessors_; }
+
+    /// \return graph of dependencies between cached values,
+    /// built by prepareDataAccessors()
+    const DependencyGraph& dependencyGraph() const
+    { return DependencyGraph_; }
+
     /// \return (min, max) array[2] of mass range for particle combination
     /// \param pc shared pointer to ParticleCombination to get mass range of
     std::array<double, 2> massRange(const std::shared_ptr<ParticleCombination>& pc) const;
@@ -161,6 +257,11 @@ public:
     /// \return free amplitudes of DecayChannels_
     ComplexParameterVector freeAmplitudes() const;
 
+    /// \return whether all parameters besides the free amplitudes of
+    /// the initial-state particle's DecayChannel's are fixed, in which
+    /// case the amplitude is linear in those free amplitudes
+    bool linearInFreeAmplitudes() const;
+
     /// @}
 
     /// \name Setters
@@ -180,6 +281,43 @@ public:
     /// set coordinate system
     void setCoordinateSystem(const CoordinateSystem<double, 3>& cs);
 
+    /// Set precision with which all static data accessors store their
+    /// values; takes effect for data sets created afterwards.
+    /// Throws while data sets of the model exist, since they share its data layout.
+    /// \param p StoragePrecision to store with
+    void setStoragePrecision(StoragePrecision p);
+
+    /// Set policy for storing values of all static data accessors
+    /// but the four momenta, which are always stored;
+    /// takes effect for data sets created afterwards.
+    /// Throws while data sets of the model exist, since they share its data layout.
+    /// \param p StoragePolicy to follow
+    void setStoragePolicy(StoragePolicy p);
+
+    /// Resolve policies of static data accessors set to kAuto by timing
+    /// the calculation of amplitudes over a sample of data points with
+    /// their values stored and recomputed, logging the results;
+    /// without tuning, kAuto resolves to kStore.
+    /// Throws while data sets of the model exist, since they share its data layout.
+    void tuneStoragePolicy();
+
+    /// Resolve policies of static data accessors set to kAuto as in
+    /// a file written by DataSet::write, so that its layout matches the model's;
+    /// called by dataSet(const std::string&), and needed before streaming
+    /// the file with a DataPartitionStream.
+    /// Throws if the layout changes while data sets of the model exist.
+    /// \param filename name of file
+    void adoptStoragePolicies(const std::string& filename);
+
+    /// \return number of data sets of the model in existence; while there
+    /// are any, settings that change the data layout can't be changed
+    unsigned nDataSets() const
+    { return *NDataSets_; }
+
+    /// throw if data sets of the model exist
+    /// \param func name of function to report in exception
+    void assertNoDataSets(const std::string& func) const;
+
     /// @}
 
     /// \name Monte Carlo Generation
@@ -201,7 +339,21 @@ public:
 
     /// create an empty data set
     /// \param n Number of empty data points to place inside data set
-    DataSet dataSet(size_t n = 0);
+    /// \param layout memory layout of the data set
+    DataSet dataSet(size_t n = 0, DataLayout layout = kRowMajor);
+
+    /// create a data set from a file written by DataSet::write,
+    /// with its columns memory mapped from the file
+    /// \param filename name of file to map
+    DataSet dataSet(const std::string& filename);
+
+    /// Validate storage precisions of static data accessors: evaluate the
+    /// sum of the logs of the squared amplitudes over the same data points
+    /// with the precisions set and with double precision throughout.
+    /// Since this changes the data layout, no data sets of the model may exist.
+    /// \return difference of sums (set precisions minus double precision)
+    /// \param P four momenta of final-state particles of all data points, one data point after another
+    double storagePrecisionDifference(const std::vector<FourVector<double> >& P);
 
     /// Print the list of DataAccessor's
     void printDataAccessors(bool printParticleCombinations = true);
@@ -209,6 +361,9 @@ public:
     /// grant friend status to DataAccessor to register itself with this
     friend class DataAccessor;
 
+    /// grant friend status to DataSet to count itself
+    friend class DataSet;
+
     /// grant friend status to DecayingParticle to call addParticleCombination
     friend class DecayingParticle;
 
@@ -227,6 +382,41 @@ protected:
 
 private:
 
+    /// \return sum of the logs of squared amplitudes evaluated over the data partition,
+    /// leaving the partition inheriting its statuses; see #finishPartition
+    /// \param D DataPartition to evaluate over
+    /// \param global StatusManager to reset partition's statuses to
+    double logsOfSquaredAmplitudes(DataPartitionBase& D, const StatusManager& global) const;
+
+    /// \return ComponentAmplitudes kept by data set, recalculated if the data set or a
+    /// parameter other than a free amplitude has changed since they were calculated;
+    /// nullptr if not using component amplitudes or if the model is not linear in free amplitudes
+    /// \param DS DataSet to evaluate over
+    const ComponentAmplitudes* componentAmplitudes(DataSet& DS) const;
+
+    /// evaluate amplitudes over a partition block by block,
+    /// leaving the partition inheriting its statuses; see #amplitudes
+    /// \param D DataPartition to evaluate over
+    /// \param global StatusManager to reset partition's statuses to
+    /// \param reduce function called with the amplitudes of each block, in order of iteration over D
+    void blockAmplitudes(DataPartitionBase& D, const StatusManager& global,
+                         const std::function<void(const std::vector<std::complex<double> >&)>& reduce) const;
+
+    /// stop partition inheriting its statuses and set its variable statuses to unchanged
+    /// \param D DataPartition evaluated over
+    static void finishPartition(DataPartitionBase& D);
+
+    /// decide for each static data accessor whether to recompute its values
+    /// rather than store them, resolving kAuto to kStore if not yet resolved
+    void resolveStoragePolicies();
+
+    /// set static data accessors recomputed from their resolved policies,
+    /// storing also all that stored ones depend on
+    void applyStoragePolicies();
+
+    /// build table of offsets of storage rows inside a DataPoint
+    void buildDataOffsets();
+
     /// Lab coordinate system to use in calculating helicity angles
     CoordinateSystem<double, 3> CoordinateSystem_;
 
@@ -239,6 +429,50 @@ private:
     /// Set of all DataAccessor's registered to this model
     DataAccessorSet DataAccessors_;
 
+    /// offsets of storage rows inside a DataPoint, in order of
+    /// DataAccessor index, then symmetrization index;
+    /// offsets of single-precision rows count floats;
+    /// offsets of parameter-dependent rows count from the end of the static data;
+    /// offsets of recomputed rows are into the storage of recomputed values;
+    /// built by prepareDataAccessors()
+    std::vector<unsigned> DataOffsets_;
+
+    /// index into DataOffsets_ of first row of each DataAccessor, followed by number of rows
+    std::vector<unsigned> DataOffsetIndices_;
+
+    /// number of doubles stored in a DataPoint
+    unsigned DataPointSize_;
+
+    /// number of doubles of static data stored in a DataPoint
+    unsigned StaticDataSize_;
+
+    /// index of first double in a DataPoint holding single-precision values
+    unsigned SinglePrecisionOffset_;
+
+    /// number of doubles recomputed for a DataPoint rather than stored in it
+    unsigned RecomputedDataSize_;
+
+    /// number of data sets of the model in existence, which share its data layout;
+    /// shared with the data sets, which may outlive the model
+    std::shared_ptr<std::atomic<unsigned> > NDataSets_;
+
+    /// graph of dependencies between cached values
+    DependencyGraph DependencyGraph_;
+
+    /// static data accessors, ordered such that each comes after those it
+    /// depends on; built by prepareDataAccessors()
+    std::vector<StaticDataAccessor*> StaticDataAccessors_;
+
+    /// decaying particles of the decay tree, each after its daughters,
+    /// ending with the initial-state particle; built by prepareDataAccessors()
+    std::vector<const DecayingParticle*> DecayingParticles_;
+
+    /// log of changes to parameters cached values depend on
+    std::shared_ptr<ParameterChangeLog> ParameterChangeLog_;
+
+    /// whether to evaluate from ComponentAmplitudes, see #setUseComponentAmplitudes
+    bool UseComponentAmplitudes_;
+
     /// Raw pointer to initial-state particle
     std::shared_ptr<DecayingParticle> InitialStateParticle_;
 
@@ -0,0 +1,129 @@
+/*  YAP - Yet another PWA toolkit
+    Copyright 2015, Technische Universitaet Muenchen,
+    Authors: Daniel Greenwald, Johannes Rauch
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// \file
+
+#ifndef yap_NormalizationIntegral_h
+#define yap_NormalizationIntegral_h
+
+#include "AmplitudeTerm.h"
+#include "DataPartition.h"
+#include "StatusManager.h"
+
+#include <complex>
+#include <vector>
+
+namespace yap {
+
+class DataSet;
+class Model;
+class ThreadPool;
+
+/// \class NormalizationIntegral
+/// \brief Calculates the integral of the squared amplitude over a (Monte Carlo) DataSet
+/// \author Johannes Rauch, Daniel Greenwald
+/// \ingroup Data
+///
+/// The amplitude is a sum of terms c_j * F_j(x) (see #AmplitudeTerm),
+/// so the integral of its square is sum_jk c_j * M_jk * c_k^*, with the
+/// interference matrix M_jk = sum_x F_j(x) * F_k(x)^*. M is cached for
+/// the generation of the data set last integrated over (see
+/// DataSet::generation); update() recalculates only the rows of terms
+/// whose fixed amplitudes depend on parameters changed since, evaluating
+/// only those terms' DecayChannel's, and integral() then costs O(K^2) for K terms.
+class NormalizationIntegral
+{
+public:
+
+    /// Constructor
+    /// \param m Model to integrate amplitude of
+    NormalizationIntegral(const Model& m);
+
+    /// update interference matrix for changed terms, calculating over
+    /// the partitions bound to the threads of a ThreadPool
+    /// \param DS DataSet to integrate over
+    /// \param pool ThreadPool holding partitions of DS
+    void update(DataSet& DS, ThreadPool& pool);
+
+    /// update interference matrix for changed terms
+    /// \param DS DataSet to integrate over
+    void update(DataSet& DS);
+
+    /// \return integral of squared amplitude over data set, using current values of free amplitudes
+    double integral() const;
+
+    /// \return element of interference matrix
+    /// \param j index of term
+    /// \param k index of term
+    const std::complex<double>& interference(size_t j, size_t k) const
+    { return Interference_[j * Terms_.size() + k]; }
+
+    /// \return terms of amplitude
+    const AmplitudeTermVector& terms() const
+    { return Terms_; }
+
+    /// \return number of data points integrated over
+    size_t nDataPoints() const
+    { return NDataPoints_; }
+
+private:
+
+    /// update calculation statuses of data set and of interference matrix
+    /// \return indices of terms whose rows must be recalculated
+    /// \param DS DataSet to integrate over
+    std::vector<size_t> changedTerms(DataSet& DS);
+
+    /// mark interference matrix as calculated for data set
+    /// \param DS DataSet integrated over
+    void finishUpdate(DataSet& DS);
+
+    /// \return partial interference matrix rows for terms over partition
+    /// \param D DataPartition to calculate over
+    /// \param global StatusManager to reset partition's statuses to
+    /// \param rows indices of terms to calculate rows of
+    std::vector<std::complex<double> > partialRows(DataPartitionBase* D, const StatusManager& global, const std::vector<size_t>& rows) const;
+
+    /// store rows into interference matrix, and their conjugates into its columns
+    /// \param rows indices of terms
+    /// \param R rows of interference matrix
+    void setRows(const std::vector<size_t>& rows, const std::vector<std::complex<double> >& R);
+
+    /// Model to integrate amplitude of
+    const Model* Model_;
+
+    /// terms of amplitude
+    AmplitudeTermVector Terms_;
+
+    /// interference matrix: index = j * number of terms + k
+    std::vector<std::complex<double> > Interference_;
+
+    /// calculation statuses of the values the interference matrix was
+    /// calculated with; a term's row is current if its fixed amplitude is calculated
+    StatusManager Statuses_;
+
+    /// generation of DataSet last integrated over
+    unsigned long DataSetGeneration_;
+
+    /// number of data points integrated over
+    size_t NDataPoints_;
+
+};
+
+}
+
+#endif
@@ -25,6 +25,7 @@
 #include "logging.h"
 #include "VariableStatus.h"
 
+#include <algorithm>
 #include <complex>
 #include <memory>
 #include <set>
@@ -32,6 +33,70 @@
 
 namespace yap {
 
+class ParameterBase;
+
+/// \class ParameterChangeLog
+/// \brief Records, in order, the parameters that have been changed
+/// \author Daniel Greenwald
+/// \ingroup Parameters
+///
+/// Readers remember a position in the log and later read back the
+/// parameters changed since. Positions count all entries ever recorded;
+/// when the log exceeds its capacity, its entries are dropped and readers
+/// positioned before them must check all parameters instead.
+class ParameterChangeLog
+{
+public:
+
+    /// Constructor
+    /// \param capacity number of entries to hold before dropping them
+    explicit ParameterChangeLog(size_t capacity = 4096)
+        : Capacity_(capacity), Offset_(0) {}
+
+    /// \return position after the last entry recorded
+    size_t position() const
+    { return Offset_ + Entries_.size(); }
+
+    /// \return whether all entries since position pos are held
+    bool holds(size_t pos) const
+    { return pos >= Offset_ and pos <= position(); }
+
+    /// \return pointer to first entry since position pos, which must be held
+    ParameterBase* const* begin(size_t pos) const
+    { return Entries_.data() + (pos - Offset_); }
+
+    /// \return pointer past last entry
+    ParameterBase* const* end() const
+    { return Entries_.data() + Entries_.size(); }
+
+    /// record change of parameter
+    void record(ParameterBase* p)
+    {
+        if (Entries_.size() >= Capacity_)
+            clear();
+        Entries_.push_back(p);
+    }
+
+    /// drop all entries, so that all readers must check all parameters
+    void clear()
+    {
+        Offset_ += Entries_.size();
+        Entries_.clear();
+    }
+
+private:
+
+    /// number of entries to hold
+    size_t Capacity_;
+
+    /// position of first entry held
+    size_t Offset_;
+
+    /// parameters changed
+    std::vector<ParameterBase*> Entries_;
+
+};
+
 /// \class ParameterBase
 /// \brief Class holding basic properties of a parameter, but not a value!
 /// \author Johannes Rauch, Daniel Greenwald
@@ -49,15 +114,45 @@ public:
     VariableStatus variableStatus() const
     { return VariableStatus_; }
 
-    /// set VariableStatus
+    /// set VariableStatus; records change in all change logs
     void setVariableStatus(VariableStatus stat)
-    { VariableStatus_ = stat; }
+    {
+        VariableStatus_ = stat;
+        if (stat == kChanged)
+            recordChange();
+    }
+
+    /// add change log to record changes in, e.g. of each model
+    /// the parameter belongs to; only changes made afterwards are recorded
+    void addChangeLog(const std::shared_ptr<ParameterChangeLog>& log)
+    {
+        if (!log)
+            throw exceptions::Exception("ParameterChangeLog unset", "ParameterBase::addChangeLog");
+        for (const auto& l : ChangeLogs_)
+            if (l.lock() == log)
+                return;
+        ChangeLogs_.push_back(log);
+    }
 
 private:
 
+    /// record change in all change logs, dropping logs no longer in use
+    void recordChange()
+    {
+        ChangeLogs_.erase(std::remove_if(ChangeLogs_.begin(), ChangeLogs_.end(),
+                                         [](const std::weak_ptr<ParameterChangeLog>& l) { return l.expired(); }),
+                          ChangeLogs_.end());
+        for (const auto& l : ChangeLogs_)
+            if (auto log = l.lock())
+                log->record(this);
+    }
+
     /// Status of variable
     VariableStatus VariableStatus_;
 
+    /// logs to record changes in
+    std::vector<std::weak_ptr<ParameterChangeLog> > ChangeLogs_;
+
 };
 
 /// \typedef ParameterVector
@@ -27,6 +27,7 @@
 #include "ReportsModel.h"
 #include "ReportsParticleCombinations.h"
 
+#include <complex>
 #include <memory>
 #include <string>
 #include <vector>
@@ -68,6 +69,16 @@ public:
     virtual std::complex<double> amplitude(DataPoint& d, const std::shared_ptr<ParticleCombination>& pc,
                                            int two_m, StatusManager& sm) const = 0;
 
+    /// Calculate complex amplitudes for all spin projections at once.
+    /// The default implementation calls amplitude(...) for each spin projection;
+    /// derived classes override it to share work across projections.
+    /// \return vector of amplitudes indexed by spin_projection_index
+    /// \param d DataPoint to calculate with
+    /// \param pc (shared_ptr to) ParticleCombination to calculate for
+    /// \param sm StatusManager to update
+    virtual std::vector<std::complex<double> > amplitudes(DataPoint& d, const std::shared_ptr<ParticleCombination>& pc,
+                                                          StatusManager& sm) const;
+
     /// Check consitency of object
     virtual bool consistent() const override;
 
@@ -84,7 +95,7 @@ public:
     { return QuantumNumbers_; }
 
     /// Get mass [GeV]
-    std::shared_ptr<RealParameter> mass() const
+    const std::shared_ptr<RealParameter>& mass() const
     { return Mass_; }
 
     /// Get name (const)
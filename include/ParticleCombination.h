@@ -65,6 +65,11 @@ public:
     std::shared_ptr<ParticleCombination> parent() const
     { return Parent_.lock(); }
 
+    /// \return dense integer ID assigned by ParticleCombinationCache::setIds;
+    /// -1 if unassigned
+    int id() const
+    { return Id_; }
+
     /// @}
 
     /// \return whether ParticleCombination is for a final state particle
@@ -103,6 +108,9 @@ private:
     /// vector indices of daughters
     std::vector<unsigned> Indices_;
 
+    /// dense integer ID
+    int Id_ = -1;
+
     /// \name private constructors
     /// for valid use of shared_from_this()
     /// @{
@@ -84,6 +84,11 @@ public:
     /// \return weak_ptr to ParticleCombination; is empty if not found.
     weak_ptr_type findByUnorderedContent(const std::vector<unsigned>& I) const;
 
+    /// assign dense integer IDs, starting from zero, to all cached
+    /// ParticleCombination's and (recursively) their daughters
+    /// \return number of IDs assigned
+    unsigned setIds();
+
     /// Check consistency of cache.
     bool consistent() const;
 
@@ -61,7 +61,7 @@ public:
     virtual void setParameters(const ParticleTableEntry& entry) override;
 
     /// Get mass
-    std::shared_ptr<ComplexParameter> mass() const
+    const std::shared_ptr<ComplexParameter>& mass() const
     { return Mass_; }
 
     /// Check consistency of object
@@ -72,6 +72,11 @@ public:
 
 protected:
 
+    /// Calculate complex amplitude without caching
+    /// \param d DataPoint to calculate with
+    /// \param pc (shared_ptr to) ParticleCombination to calculate for
+    virtual std::complex<double> calc(const DataPoint& d, const std::shared_ptr<ParticleCombination>& pc) const override;
+
     /// borrow mass from owner
     virtual void setDependenciesFromResonance() override;
 
@@ -65,9 +65,24 @@ public:
     /// \param sm StatusManager to update
     virtual std::complex<double> amplitude(DataPoint& d, const std::shared_ptr<ParticleCombination>& pc, int two_m, StatusManager& sm) const override;
 
+    /// Calculate complex amplitudes for all spin projections,
+    /// evaluating the mass shape once for all of them
+    /// \param d DataPoint to calculate with
+    /// \param pc (shared_ptr to) ParticleCombination to calculate for
+    /// \param sm StatusManager to update
+    virtual std::vector<std::complex<double> > amplitudes(DataPoint& d, const std::shared_ptr<ParticleCombination>& pc, StatusManager& sm) const override;
+
+    /// Calculate and cache amplitudes and mass shape for all points of a block
+    /// \param B block of data points to calculate for
+    /// \param sm StatusManager to update, shared by all points of the block
+    virtual void calculate(const DataPointBlock& B, StatusManager& sm) const override;
+
     /// Check consistency of object
     virtual bool consistent() const override;
 
+    /// \return DecayingParticle's cached amplitudes and MassShape's cached amplitude
+    virtual CachedDataValueSet cachedDataValuesItDependsOn() override;
+
     /// \name Getters
     /// @{
 
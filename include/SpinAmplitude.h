@@ -23,11 +23,13 @@
 
 #include "CachedDataValue.h"
 #include "MathUtilities.h"
+#include "spin.h"
 #include "StaticDataAccessor.h"
 
 #include <array>
 #include <cstdlib>
 #include <memory>
+#include <vector>
 
 namespace yap {
 
@@ -52,6 +54,11 @@ public:
     /// \brief maps parent spin projectin to AmplitudeSubmap
     using AmplitudeMap = std::map<int, AmplitudeSubmap>;
 
+    /// \typedef AmplitudeVector
+    /// \brief flat vector of SpinProjectionPair's and their cached amplitudes,
+    /// for one parent spin projection
+    using AmplitudeVector = std::vector<std::pair<SpinProjectionPair, ComplexCachedDataValue*> >;
+
     /// \return whether three spins fulfill the triangle relationship
     /// \param two_a 2 * spin a
     /// \param two_b 2 * spin b
@@ -150,6 +157,11 @@ public:
     const AmplitudeMap& amplitudes() const
     { return Amplitudes_; }
 
+    /// \return cached amplitudes for parent spin projection, as flat vector
+    /// \param two_M 2 * spin projection of parent
+    const AmplitudeVector& amplitudes(int two_M) const
+    { return AmplitudeVectors_[spin_projection_index(two_M, InitialTwoJ_)]; }
+
     virtual std::string data_accessor_type() const override
     {return "SpinAmplitude"; }
 
@@ -211,6 +223,10 @@ private:
     /// Cached complex spin amplitude
     AmplitudeMap Amplitudes_;
 
+    /// Cached complex spin amplitudes, as flat vectors
+    /// indexed by spin_projection_index of parent spin projection
+    std::vector<AmplitudeVector> AmplitudeVectors_;
+
     /// equality operator
     friend bool operator==(const SpinAmplitude& A, const SpinAmplitude& B)
     { return typeid(A) == typeid(B) and A.equals(B); }
@@ -31,6 +31,21 @@ class StatusManager;
 
 class Model;
 
+/// \enum StoragePolicy
+/// \brief whether a StaticDataAccessor's values are stored in data points or recomputed
+/// \ingroup Data
+enum StoragePolicy {
+    /// values are calculated when data points are added and stored in them
+    kStore,
+    /// values are not stored, but recalculated from stored data
+    /// whenever the amplitude of a data point is calculated
+    kRecompute,
+    /// kStore, unless chosen otherwise by Model::tuneStoragePolicy, which times the
+    /// calculation of amplitudes over a sample of data points with the values stored
+    /// and recomputed, or adopted from a file by Model::adoptStoragePolicies
+    kAuto
+};
+
 /// \name StaticDataAccessor
 /// \brief Base class for all data accessors that will only write to DataPoint once at initial data loading
 /// \author Johannes Rauch, Daniel Greenwald
@@ -41,14 +56,16 @@ public:
     /// Constructor
     /// \param equiv ParticleCombination equivalence struct for determining index assignments
     StaticDataAccessor(ParticleCombination::Equiv* equiv = &ParticleCombination::equivBySharedPointer)
-        : DataAccessor(equiv), Model_(nullptr) {}
+        : DataAccessor(equiv), Model_(nullptr), StoragePolicy_(kStore), ResolvedStoragePolicy_(kStore)
+    { setStatic(); }
 
     /// Constructor
     /// \param model Raw pointer to owning Model
     /// \param equiv ParticleCombination equivalence struct for determining index assignments
     StaticDataAccessor(Model* m, ParticleCombination::Equiv* equiv = &ParticleCombination::equivBySharedPointer)
-        : DataAccessor(equiv), Model_(nullptr)
+        : DataAccessor(equiv), Model_(nullptr), StoragePolicy_(kStore), ResolvedStoragePolicy_(kStore)
     {
+        setStatic();
         setModel(m);
     }
 
@@ -68,14 +85,47 @@ public:
     /// Must be overriden in derived classes.
     virtual void calculate(DataPoint& d, StatusManager& sm) const = 0;
 
+    /// Set precision with which values are stored in data points.
+    /// Values are always calculated in double precision;
+    /// single precision halves their storage at the cost of rounding them.
+    /// Takes effect for data sets created afterwards;
+    /// throws while data sets of the model exist.
+    /// \param p StoragePrecision to store with
+    void setPrecision(StoragePrecision p);
+
+    /// \return policy for storing values
+    StoragePolicy storagePolicy() const
+    { return StoragePolicy_; }
+
+    /// Set policy for storing values; it is resolved by
+    /// Model::prepareDataAccessors and so takes effect for data sets created afterwards;
+    /// throws while data sets of the model exist.
+    /// Accessors that stored accessors depend on are always stored.
+    /// \param p StoragePolicy to follow
+    virtual void setStoragePolicy(StoragePolicy p);
+
+    /// \return policy for storing values, with kAuto resolved to kStore or kRecompute;
+    /// kAuto until resolved by Model::prepareDataAccessors
+    StoragePolicy resolvedStoragePolicy() const
+    { return ResolvedStoragePolicy_; }
+
     /// \return Raw pointer to owning Model
     const Model* model() const override
     { return Model_; }
 
+    /// grant friend status to Model to resolve storage policy
+    friend class Model;
+
 private:
 
     Model* Model_;
 
+    /// policy for storing values
+    StoragePolicy StoragePolicy_;
+
+    /// policy for storing values, with kAuto resolved once
+    StoragePolicy ResolvedStoragePolicy_;
+
 };
 
 }
@@ -28,7 +28,17 @@
 namespace yap {
 
 class CachedDataValue;
-
+class DependencyGraph;
+class ParameterChangeLog;
+
+/// \class StatusManager
+/// \brief Holds calculation and variable statuses of all CachedDataValue's
+/// \ingroup Cache
+///
+/// Calculation statuses can be inherited lazily from another
+/// StatusManager (see inheritCalculationStatuses): each status is then
+/// copied on first access, tracked by comparing its epoch stamp to the
+/// manager's epoch, so that resetting all statuses costs O(1).
 class StatusManager
 {
 public:
@@ -37,6 +47,12 @@ public:
     /// \param sDA DataAccessorSet to construct StatusManager for
     StatusManager(const DataAccessorSet& sDA);
 
+    /// copy constructor; copies calculation statuses eagerly
+    StatusManager(const StatusManager& other);
+
+    /// copy assignment operator; copies calculation statuses eagerly
+    StatusManager& operator=(const StatusManager& other);
+
     /// \name direct access to individual statuses
     /// @{
 
@@ -46,7 +62,14 @@ public:
     /// \param cdv_index Index of CachedDataValue
     /// \param sym_index Index of symmetrization
     CachedDataValue::Status& status(size_t da_index, size_t cdv_index, size_t sym_index)
-    { return Statuses_[da_index][cdv_index][sym_index]; }
+    {
+        auto& S = Statuses_[da_index][cdv_index][sym_index];
+        if (Inherited_ and S.Epoch != Epoch_) {
+            S.Calculation = Inherited_->Statuses_[da_index][cdv_index][sym_index].Calculation;
+            S.Epoch = Epoch_;
+        }
+        return S;
+    }
 
     /// retrieve status (const)
     /// \return CachedDataValue::Status (const)
@@ -94,9 +117,26 @@ public:
     /// \param sm StatusManager to copy from
     void copyCalculationStatuses(const StatusManager& sm);
 
+    /// reset all calculation statuses to those of another manager in O(1):
+    /// each status is copied on its first access afterwards.
+    /// sm must neither change nor be destroyed until the next call
+    /// to inheritCalculationStatuses, copyCalculationStatuses, or
+    /// detachCalculationStatuses
+    /// \param sm StatusManager to inherit from
+    void inheritCalculationStatuses(const StatusManager& sm);
+
+    /// copy all calculation statuses not yet accessed since the last call to
+    /// inheritCalculationStatuses, and stop inheriting
+    void detachCalculationStatuses();
+
     /// update CalculationStatus'es
     void updateCalculationStatuses(const DataAccessorSet& sDA);
 
+    /// update CalculationStatus'es in one pass over a precompiled graph,
+    /// checking only parameters changed since the last call
+    /// \param G DependencyGraph of the DataAccessor's this manager was constructed for
+    void updateCalculationStatuses(const DependencyGraph& G);
+
 private:
 
     /// update CalculationStatus'es for a particular CachedDataValue;
@@ -113,6 +153,18 @@ private:
     /// third index is for SymmetrizationIndex
     std::vector<std::vector<std::vector<CachedDataValue::Status> > > Statuses_;
 
+    /// StatusManager calculation statuses are inherited from, if any
+    const StatusManager* Inherited_;
+
+    /// current epoch, incremented by inheritCalculationStatuses
+    unsigned Epoch_;
+
+    /// ParameterChangeLog read at last update from a DependencyGraph
+    const ParameterChangeLog* ChangeLog_;
+
+    /// position in ChangeLog_ after last update
+    size_t ChangeLogPosition_;
+
 };
 
 }
@@ -0,0 +1,123 @@
+/*  YAP - Yet another PWA toolkit
+    Copyright 2015, Technische Universitaet Muenchen,
+    Authors: Daniel Greenwald, Johannes Rauch
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// \file
+
+#ifndef yap_ThreadPool_h
+#define yap_ThreadPool_h
+
+#include "DataPartition.h"
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace yap {
+
+/// \class ThreadPool
+/// \brief Long-lived worker threads, each bound to one DataPartition
+/// \author Johannes Rauch, Daniel Greenwald
+/// \ingroup Data
+///
+/// Threads are created once, at construction, and wait between calls
+/// to run(). run() hands the workers a task by incrementing a
+/// generation counter; partition 0 is evaluated by the calling thread.
+/// The partitions must outlive the ThreadPool.
+class ThreadPool
+{
+public:
+
+    /// \typedef Task
+    /// function to call with a partition and its index
+    using Task = std::function<void(DataPartitionBase&, unsigned)>;
+
+    /// Constructor; starts one worker thread for each but the first partition
+    /// \param DP DataPartitionVector of partitions to bind to threads
+    /// \param pin_threads whether to pin each worker thread to a separate core (only on linux)
+    ThreadPool(DataPartitionVector& DP, bool pin_threads = false);
+
+    /// Destructor; stops and joins worker threads
+    ~ThreadPool();
+
+    /// copy constructor (deleted)
+    ThreadPool(const ThreadPool&) = delete;
+
+    /// copy assignment operator (deleted)
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Call task for every partition, in parallel, and wait for all to finish;
+    /// rethrows the first exception thrown by a task.
+    /// Must not be called concurrently from several threads.
+    /// \param task Task to call
+    void run(const Task& task);
+
+    /// \return number of partitions
+    size_t size() const
+    { return Partitions_.size(); }
+
+    /// \return partitions
+    DataPartitionVector& partitions()
+    { return Partitions_; }
+
+private:
+
+    /// stop and join worker threads
+    void stop();
+
+    /// loop run by worker threads
+    /// \param i index of partition bound to worker
+    void work(unsigned i);
+
+    /// partitions bound to threads
+    DataPartitionVector& Partitions_;
+
+    /// worker threads, for partitions 1 to N-1
+    std::vector<std::thread> Threads_;
+
+    /// mutex guarding all below
+    std::mutex Mutex_;
+
+    /// signals workers to start or stop
+    std::condition_variable Start_;
+
+    /// signals run() that all workers are finished
+    std::condition_variable Done_;
+
+    /// current task
+    const Task* Task_;
+
+    /// incremented for every call to run()
+    unsigned long Generation_;
+
+    /// number of workers still running current task
+    unsigned Remaining_;
+
+    /// whether to stop workers
+    bool Stop_;
+
+    /// exceptions thrown by tasks, by partition index
+    std::vector<std::exception_ptr> Exceptions_;
+
+};
+
+}
+
+#endif
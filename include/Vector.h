@@ -51,8 +51,10 @@ public:
     /// Use std::array's assignment operators
     using std::array<T, N>::operator=;
 
-    /// inner (dot) product of #Vector's
-    virtual T operator*(const Vector<T, N>& B) const
+    /// inner (dot) product of #Vector's.
+    /// Not virtual, so that #Vector's stay trivially copyable and hold no more than their elements;
+    /// classes with other inner products hide it and overload functions using it, such as #norm
+    T operator*(const Vector<T, N>& B) const
     { return std::inner_product(this->begin(), this->end(), B.begin(), T(0)); }
 };
 
@@ -144,10 +146,13 @@ Vector<T, N> unit(const Vector<T, N>& V)
 template <typename T, size_t R, size_t C>
 Vector<T, R> operator*(const Matrix<T, R, C>& M, const Vector<T, C>& V)
 {
-    Vector<T, R> v = {};
-    for (size_t r = 0; r < R; ++r)
-        for (size_t c = 0; c < C; ++c)
-            v[r] += M[r][c] * V[c];
+    Vector<T, R> v;
+    for (size_t r = 0; r < R; ++r) {
+        T sum = M[r][0] * V[0];
+        for (size_t c = 1; c < C; ++c)
+            sum += M[r][c] * V[c];
+        v[r] = sum;
+    }
     return v;
 }
 
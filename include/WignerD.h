@@ -37,6 +37,13 @@
 /// The uncached matrix elements are given by the by the symmetries
 ///   - \f$ d^{J}_{MN}(\beta) = (-)^(M-N) d^{J}_{NM}(\beta)\f$
 ///   - \f$ d^{J}_{MN}(\beta) = (-)^{M-N) d^{J}_{-N-M}(\beta)\f$
+///
+/// Whole d-matrices are calculated by the recurrence in J obtained from coupling
+/// \f$ d^{J-1/2} \f$ with \f$ d^{1/2} \f$, whose terms are all bounded by one.
+///
+/// Caches are published as a whole and never modified afterwards,
+/// so they may be read from several threads. To avoid locking during
+/// evaluation, cache up to the highest spin needed before starting threads.
 
 #ifndef yap_WignerD_h
 #define yap_WignerD_h
@@ -44,6 +51,7 @@
 #include "Constants.h"
 
 #include <complex>
+#include <vector>
 
 namespace yap {
 
@@ -60,10 +68,17 @@ inline std::complex<double> DFunction(unsigned twoJ, int twoM, int twoN, double
 
 namespace dMatrix {
 
-/// Cache d-matrix elements for representation of spin J
-/// \param twoJ twice the spin of the representation
+/// Cache d-matrix elements for representations of all spins up to J
+/// \param twoJ twice the highest spin to cache
 void cache(unsigned int twoJ);
 
+/// Calculate all elements of the d-matrix \f$ d^{J}(\beta) \f$ by recurrence in J
+/// \param twoJ twice the spin of the representation
+/// \param cosBeta cosine of rotation angle, with beta in [0, pi]
+/// \param d vector to fill with d-matrix elements; \f$ d^{J}_{MN} \f$ is at
+/// spin_projection_index(M, twoJ) * (twoJ + 1) + spin_projection_index(N, twoJ)
+void calculate(unsigned twoJ, double cosBeta, std::vector<double>& d);
+
 /// \return cache size in bytes
 unsigned cacheSize();
 
@@ -0,0 +1,145 @@
+/*  YAP - Yet another PWA toolkit
+    Copyright 2015, Technische Universitaet Muenchen,
+    Authors: Daniel Greenwald, Johannes Rauch
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// \file
+
+#ifndef yap_WorkStealingScheduler_h
+#define yap_WorkStealingScheduler_h
+
+#include "DataPartition.h"
+#include "ThreadPool.h"
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace yap {
+
+class DataSet;
+class Model;
+
+/// \class WorkStealingScheduler
+/// \brief Distributes small chunks of a DataSet dynamically over worker threads
+/// \author Johannes Rauch, Daniel Greenwald
+/// \ingroup Data
+///
+/// At each call to run(), the DataSet is cut into many contiguous
+/// chunks, which are dealt out in blocks to the workers' queues. A worker
+/// takes chunks from the front of its own queue and, once that is empty,
+/// steals from the back of the other workers' queues, so that a slow
+/// worker does not stall the others. Each worker owns one DataPartition
+/// (and so one StatusManager) that is pointed at the chunk being
+/// calculated. Workers are the threads of a #ThreadPool.
+class WorkStealingScheduler
+{
+public:
+
+    /// \typedef Task
+    /// function to call with a worker's partition, pointed at a chunk, and the worker's index
+    using Task = ThreadPool::Task;
+
+    /// Constructor
+    /// \param m Model whose data sets to schedule calculation over
+    /// \param n_workers number of worker threads
+    /// \param chunk_size number of data points per chunk;
+    /// if zero, chosen such that a chunk's data fills 256 kB
+    WorkStealingScheduler(const Model& m, unsigned n_workers, size_t chunk_size = 0);
+
+    /// Call task for every chunk of a data set, in parallel, and wait for all to finish;
+    /// a task may be called several times for the same worker.
+    /// Must not be called concurrently from several threads.
+    /// \param DS DataSet to calculate over
+    /// \param task Task to call for each chunk
+    /// \param finish Task to call once for each worker after its last chunk, if set
+    void run(DataSet& DS, const Task& task, const Task& finish = Task());
+
+    /// \return number of workers
+    size_t size() const
+    { return Workers_.size(); }
+
+    /// \return number of data points per chunk
+    size_t chunkSize() const
+    { return ChunkSize_; }
+
+private:
+
+    /// \typedef Chunk
+    /// range of indices of data points
+    using Chunk = std::pair<size_t, size_t>;
+
+    /// \class WorkerPartition
+    /// \brief DataPartitionBlock that can be pointed at a chunk
+    class WorkerPartition : public DataPartitionBlock
+    {
+    public:
+
+        /// Constructor
+        /// \param sDA DataAccessorSet to initialize StatusManager from
+        WorkerPartition(const DataAccessorSet& sDA)
+            : DataPartitionBlock(sDA) {}
+
+        /// point partition at chunk
+        /// \param DS DataSet chunk is in
+        /// \param c Chunk
+        void setChunk(DataSet& DS, const Chunk& c)
+        { setBegin(begin(DS) + c.first); setEnd(begin(DS) + c.second); }
+
+        /// \return partitions for workers
+        /// \param m Model to initialize StatusManager's from
+        /// \param n number of workers
+        static DataPartitionVector createWorkers(const Model& m, unsigned n);
+    };
+
+    /// \struct Queue
+    /// \brief A worker's queue of chunk indices
+    struct Queue {
+        /// mutex guarding Chunks
+        std::mutex Mutex;
+
+        /// indices of chunks
+        std::deque<size_t> Chunks;
+    };
+
+    /// \return index of next chunk for worker, taken from own queue or stolen from others' queues;
+    /// false if no chunks are left
+    /// \param i index of worker
+    /// \param c index of chunk to fill
+    bool nextChunk(unsigned i, size_t& c);
+
+    /// number of data points per chunk
+    size_t ChunkSize_;
+
+    /// chunks covering data set of current run
+    std::vector<Chunk> Chunks_;
+
+    /// partitions of workers
+    DataPartitionVector Workers_;
+
+    /// queues of workers
+    std::vector<Queue> Queues_;
+
+    /// threads running workers
+    ThreadPool Pool_;
+
+};
+
+}
+
+#endif
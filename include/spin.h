@@ -31,6 +31,12 @@ namespace yap {
 inline std::string spin_to_string(int twoJ)
 { return is_even(twoJ) ? std::to_string(twoJ / 2) : std::to_string(twoJ) + "/2"; }
 
+/// \return index of spin projection in dense arrays over -J, -J + 1, ..., J
+/// \param two_m 2 * spin projection
+/// \param two_J 2 * spin
+inline unsigned spin_projection_index(int two_m, unsigned two_J)
+{ return (two_m + (int)two_J) / 2; }
+
 }
 
 #endif
@@ -113,6 +113,19 @@ int main( int argc, char** argv)
 
     std::vector<double> m2 = {1, 1};//{0.9, 1.1}; //{0.1, 4};
 
+    // validate single-precision storage of static data over a grid on the Dalitz plot;
+    // this must be done before creating data sets, which fix the storage precision
+    std::vector<yap::FourVector<double> > grid;
+    for (unsigned i = 0; i <= 20; ++i)
+        for (unsigned j = 0; j <= 20; ++j) {
+            auto p = M.calculateFourMomenta(massAxes, {0.1 + 2.9 * i / 20, 0.1 + 2.9 * j / 20});
+            grid.insert(grid.end(), p.begin(), p.end());
+        }
+    M.setStoragePrecision(yap::kSinglePrecision);
+    double dL = M.storagePrecisionDifference(grid);
+    LOG(INFO) << "single-precision storage changes sum of logs of squared amplitudes by " << dL;
+    M.setStoragePrecision(yap::kDoublePrecision);
+
     // create data set with 1 empty data point
     auto data = M.dataSet(1);
 
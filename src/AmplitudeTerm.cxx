@@ -0,0 +1,60 @@
+#include "AmplitudeTerm.h"
+
+#include "CachedDataValue.h"
+#include "DecayChannel.h"
+#include "DecayingParticle.h"
+#include "Exceptions.h"
+#include "MassShape.h"
+#include "Model.h"
+#include "Resonance.h"
+
+namespace yap {
+
+//-------------------------
+std::complex<double> AmplitudeTerm::fixedAmplitude(const DataPoint& d) const
+{
+    std::complex<double> a = Complex_0;
+    if (MassShape)
+        for (size_t i = 0; i < SymmetrizationIndices.size(); ++i)
+            a += Fixed->value(d, SymmetrizationIndices[i]) * MassShape->value(d, MassShapeSymmetrizationIndices[i]);
+    else
+        for (auto s : SymmetrizationIndices)
+            a += Fixed->value(d, s);
+    return a;
+}
+
+//-------------------------
+AmplitudeTermVector amplitudeTerms(const Model& m)
+{
+    auto isp = m.initialStateParticle();
+    if (!isp)
+        throw exceptions::Exception("Initial state unset", "amplitudeTerms");
+
+    // mass shape multiplying the amplitude of a resonant initial state
+    auto res = std::dynamic_pointer_cast<const Resonance>(isp);
+    auto mass_shape = res ? res->massShape()->T() : nullptr;
+
+    AmplitudeTermVector T;
+
+    // one term per channel, spin amplitude, and spin projection
+    for (auto& c : isp->channels()) {
+
+        // channel's (and mass shape's) symmetrization indices for ISP's particle combinations
+        std::vector<unsigned> sym_indices;
+        std::vector<unsigned> mass_shape_sym_indices;
+        for (auto& kv : isp->symmetrizationIndices())
+            if (c->hasParticleCombination(kv.first)) {
+                sym_indices.push_back(c->symmetrizationIndex(kv.first));
+                if (res)
+                    mass_shape_sym_indices.push_back(res->massShape()->symmetrizationIndex(kv.first));
+            }
+
+        for (auto& sa : c->spinAmplitudes())
+            for (auto& kv : c->amplitudes(sa))
+                T.push_back({c, kv.second.Free, kv.second.Fixed, sym_indices, mass_shape, mass_shape_sym_indices});
+    }
+
+    return T;
+}
+
+}
@@ -8,6 +8,8 @@
 #include "MeasuredBreakupMomenta.h"
 #include "Model.h"
 
+#include <algorithm>
+
 namespace yap {
 
 //-------------------------
@@ -86,6 +88,57 @@ double BlattWeisskopf::amplitude(DataPoint& d, const std::shared_ptr<ParticleCom
     return Fq_r->value(d, symIndex) / Fq_ab->value(d, symIndex);
 }
 
+//-------------------------
+void BlattWeisskopf::barrierFactors(std::vector<double>& z) const
+{
+    // switch outside of loops, so that each loop can be vectorized
+    switch (L_) {
+        case 0:
+            std::fill(z.begin(), z.end(), 1.);
+            break;
+        case 1:
+            for (size_t i = 0; i < z.size(); ++i)
+                z[i] = sqrt(1. + z[i]);
+            break;
+        default:
+            for (size_t i = 0; i < z.size(); ++i)
+                z[i] = sqrt(F2(L_, z[i]));
+    }
+}
+
+//-------------------------
+void BlattWeisskopf::calculate(const DataPointBlock& B, StatusManager& sm) const
+{
+    const double m2_R = pow(DecayingParticle_->mass()->value(), 2);
+    const double R2 = pow(DecayingParticle_->radialSize()->value(), 2);
+
+    std::vector<double> z(B.size());
+
+    for (const auto& kv : symmetrizationIndices()) {
+
+        const auto& pc = kv.first;
+
+        if (sm.status(*Fq_r, kv.second) == kUncalculated) {
+            // nominal breakup momentum
+            for (size_t i = 0; i < B.size(); ++i)
+                z[i] = R2 * MeasuredBreakupMomenta::calcQ2(m2_R, model()->fourMomenta()->m(*B[i], pc->daughters().at(0)),
+                                                           model()->fourMomenta()->m(*B[i], pc->daughters().at(1)));
+            barrierFactors(z);
+            for (size_t i = 0; i < B.size(); ++i)
+                Fq_r->setValue(z[i], *B[i], kv.second, sm);
+        }
+
+        if (sm.status(*Fq_ab, kv.second) == kUncalculated) {
+            // measured breakup momentum
+            for (size_t i = 0; i < B.size(); ++i)
+                z[i] = R2 * model()->measuredBreakupMomenta()->q2(*B[i], pc);
+            barrierFactors(z);
+            for (size_t i = 0; i < B.size(); ++i)
+                Fq_ab->setValue(z[i], *B[i], kv.second, sm);
+        }
+    }
+}
+
 //-------------------------
 const Model* BlattWeisskopf::model() const
 {
@@ -35,8 +35,7 @@ std::complex<double> BreitWigner::amplitude(DataPoint& d, const std::shared_ptr<
     // recalculate, cache, & return, if necessary
     if (sm.status(*T(), symIndex) == kUncalculated) {
 
-        // T = 1 / (M^2 - m^2 - iMG)
-        std::complex<double> t = 1. / (pow(mass()->value(), 2) - model()->fourMomenta()->m2(d, pc) - Complex_i * mass()->value() * width()->value());
+        std::complex<double> t = calc(d, pc);
 
         T()->setValue(t, d, symIndex, sm);
 
@@ -50,6 +49,42 @@ std::complex<double> BreitWigner::amplitude(DataPoint& d, const std::shared_ptr<
     return T()->value(d, symIndex);
 }
 
+//-------------------------
+std::complex<double> BreitWigner::calc(const DataPoint& d, const std::shared_ptr<ParticleCombination>& pc) const
+{
+    // T = 1 / (M^2 - m^2 - iMG)
+    return 1. / (pow(mass()->value(), 2) - model()->fourMomenta()->m2(d, pc) - Complex_i * mass()->value() * width()->value());
+}
+
+//-------------------------
+void BreitWigner::calculate(const DataPointBlock& B, StatusManager& sm) const
+{
+    // T = 1 / (M^2 - m^2 - iMG) = (M^2 - m^2 + iMG) / ((M^2 - m^2)^2 + (MG)^2)
+    const double M2 = pow(mass()->value(), 2);
+    const double MG = mass()->value() * width()->value();
+
+    std::vector<double> re(B.size());
+    std::vector<double> im(B.size());
+
+    for (const auto& kv : symmetrizationIndices()) {
+
+        if (sm.status(*T(), kv.second) != kUncalculated)
+            continue;
+
+        for (size_t i = 0; i < B.size(); ++i)
+            re[i] = M2 - model()->fourMomenta()->m2(*B[i], kv.first);
+
+        for (size_t i = 0; i < B.size(); ++i) {
+            const double n = 1. / (re[i] * re[i] + MG * MG);
+            re[i] *= n;
+            im[i] = MG * n;
+        }
+
+        for (size_t i = 0; i < B.size(); ++i)
+            T()->setValue(std::complex<double>(re[i], im[i]), *B[i], kv.second, sm);
+    }
+}
+
 //-------------------------
 bool BreitWigner::consistent() const
 {
@@ -4,6 +4,7 @@
 #include "DataPoint.h"
 #include "Exceptions.h"
 #include "logging.h"
+#include "Model.h"
 #include "StatusManager.h"
 
 namespace yap {
@@ -11,7 +12,8 @@ namespace yap {
 //-------------------------
 CachedDataValue::Status::Status() :
     Calculation(kUncalculated),
-    Variable(kChanged)
+    Variable(kChanged),
+    Epoch(0)
 {}
 
 
@@ -22,6 +24,8 @@ CachedDataValue::CachedDataValue(unsigned size, ParameterSet pars, CachedDataVal
     Index_(-1),
     Position_(-1),
     Size_(size),
+    Read_(nullptr),
+    Write_(nullptr),
     ParametersItDependsOn_(pars),
     CachedDataValuesItDependsOn_(vals)
 {
@@ -30,23 +34,27 @@ CachedDataValue::CachedDataValue(unsigned size, ParameterSet pars, CachedDataVal
 }
 
 //-------------------------
-double CachedDataValue::value(unsigned index, const DataPoint& d, unsigned sym_index) const
+void CachedDataValue::setDataOffsets(const std::vector<unsigned>& offsets)
 {
-#ifdef ELPP_DISABLE_DEBUG_LOGS
-    return d.Data_[Owner_->index()][sym_index][Position_ + index];
-#else
-    return d.Data_.at(Owner_->index()).at(sym_index).at(Position_ + index);
-#endif
-}
-
-//-------------------------
-void CachedDataValue::setValue(unsigned index, double val, DataPoint& d, unsigned sym_index) const
-{
-#ifdef ELPP_DISABLE_DEBUG_LOGS
-    d.Data_[Owner_->index()][sym_index][Position_ + index] = val;
-#else
-    d.Data_.at(Owner_->index()).at(sym_index).at(Position_ + index) = val;
-#endif
+    Offsets_.clear();
+    for (auto o : offsets)
+        Offsets_.push_back(o + Position_);
+
+    // decide where values are stored once for all reads and writes
+    if (!Owner_->isStatic()) {
+        Read_ = &DataPoint::readDynamicElement;
+        Write_ = &DataPoint::writeDynamicElement;
+    } else if (Owner_->recomputed()) {
+        Read_ = &DataPoint::readRecomputedElement;
+        Write_ = &DataPoint::writeRecomputedElement;
+    } else if (Owner_->precision() == kSinglePrecision) {
+        // single-precision values are widened on read
+        Read_ = &DataPoint::readSingleElement;
+        Write_ = &DataPoint::writeSingleElement;
+    } else {
+        Read_ = &DataPoint::readElement;
+        Write_ = &DataPoint::writeElement;
+    }
 }
 
 //-------------------------
@@ -0,0 +1,83 @@
+#include "ComponentAmplitudes.h"
+
+#include "AmplitudeTerm.h"
+#include "Constants.h"
+#include "DataSet.h"
+#include "Exceptions.h"
+#include "Model.h"
+#include "StatusManager.h"
+
+namespace yap {
+
+//-------------------------
+ComponentAmplitudes::ComponentAmplitudes(const Model& m, DataSet& data) :
+    NDataPoints_(data.points().size())
+{
+    if (data.model() != &m)
+        throw exceptions::Exception("DataSet does not belong to Model", "ComponentAmplitudes::ComponentAmplitudes");
+
+    if (!m.linearInFreeAmplitudes())
+        throw exceptions::Exception("Model is not linear in free amplitudes", "ComponentAmplitudes::ComponentAmplitudes");
+
+    auto terms = amplitudeTerms(m);
+    for (const auto& t : terms)
+        FreeAmplitudes_.push_back(t.Free);
+
+    Components_.reserve(NDataPoints_ * terms.size());
+
+    // calculate the full amplitude for each data point from scratch,
+    // which stores all fixed amplitudes in the data point
+    StatusManager uncalculated(m.dataAccessors());
+    StatusManager sm(uncalculated);
+
+    for (size_t i = 0; i < NDataPoints_; ++i) {
+        sm.inheritCalculationStatuses(uncalculated);
+        m.amplitude(data[i], sm);
+
+        for (const auto& t : terms)
+            Components_.push_back(t.fixedAmplitude(data[i]));
+    }
+    sm.detachCalculationStatuses();
+}
+
+//-------------------------
+std::vector<std::complex<double> > ComponentAmplitudes::freeAmplitudeValues() const
+{
+    std::vector<std::complex<double> > c;
+    c.reserve(FreeAmplitudes_.size());
+    for (const auto& a : FreeAmplitudes_)
+        c.push_back(a->value());
+    return c;
+}
+
+//-------------------------
+std::complex<double> ComponentAmplitudes::amplitude(size_t i, const std::vector<std::complex<double> >& c) const
+{
+    const auto* F = &Components_[i * c.size()];
+    std::complex<double> a = Complex_0;
+    for (size_t k = 0; k < c.size(); ++k)
+        a += c[k] * F[k];
+    return a;
+}
+
+//-------------------------
+std::complex<double> ComponentAmplitudes::amplitude(size_t i) const
+{
+    if (i >= NDataPoints_)
+        throw exceptions::Exception("index out of range", "ComponentAmplitudes::amplitude");
+    return amplitude(i, freeAmplitudeValues());
+}
+
+//-------------------------
+double ComponentAmplitudes::sumOfLogsOfSquaredAmplitudes() const
+{
+    auto c = freeAmplitudeValues();
+
+    double L = 0;
+    for (size_t i = 0; i < NDataPoints_; ++i)
+        L += log(norm(amplitude(i, c)));
+
+    return L;
+}
+
+}
@@ -11,7 +11,10 @@ DataAccessor::DataAccessor(ParticleCombination::Equiv* equiv) :
     ReportsParticleCombinations(),
     Equiv_(equiv),
     Size_(0),
-    Index_(-1)
+    Index_(-1),
+    Precision_(kDoublePrecision),
+    Recomputed_(false),
+    Static_(false)
 {
 }
 
@@ -95,12 +98,16 @@ unsigned DataAccessor::addParticleCombination(std::shared_ptr<ParticleCombinatio
         if ((*Equiv_)(kv.first, c)) {
             // equating member found; set index; return
             SymmetrizationIndices_[c] = kv.second;
+            if (c->id() >= 0 and c->id() < (int)SymmetrizationIndexTable_.size())
+                SymmetrizationIndexTable_[c->id()] = kv.second;
             return kv.second;
         }
 
     // else assign to current size = highest current index + 1
     unsigned size = maxSymmetrizationIndex() + 1;
     SymmetrizationIndices_[c] = size;
+    if (c->id() >= 0 and c->id() < (int)SymmetrizationIndexTable_.size())
+        SymmetrizationIndexTable_[c->id()] = size;
 
     return size;
 }
@@ -111,6 +118,9 @@ void DataAccessor::pruneSymmetrizationIndices()
     if (!model())
         throw exceptions::Exception("Model not set", "DataAccessor::pruneSymmetrizationIndices");
 
+    // table is rebuilt by Model::prepareDataAccessors
+    SymmetrizationIndexTable_.clear();
+
     // remove entries that don't trace back to the ISP
     for (auto it = SymmetrizationIndices_.begin(); it != SymmetrizationIndices_.end(); ) {
         // find the top-most parent
@@ -156,6 +166,15 @@ void DataAccessor::pruneSymmetrizationIndices()
     }
 }
 
+//-------------------------
+void DataAccessor::buildSymmetrizationIndexTable(unsigned n)
+{
+    SymmetrizationIndexTable_.assign(n, -1);
+    for (const auto& kv : SymmetrizationIndices_)
+        if (kv.first->id() >= 0 and kv.first->id() < (int)n)
+            SymmetrizationIndexTable_[kv.first->id()] = kv.second;
+}
+
 //-------------------------
 void DataAccessor::addToModel()
 {
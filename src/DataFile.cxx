@@ -0,0 +1,140 @@
+#include "DataFile.h"
+
+#include "DataAccessor.h"
+#include "Exceptions.h"
+#include "MappedFile.h"
+#include "Model.h"
+#include "StaticDataAccessor.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace yap {
+
+/// magic identifier of YAP data-set files
+static const char DataFileMagic[8] = {'Y', 'A', 'P', 'D', 'A', 'T', 'A', '\0'};
+
+/// current version of data-set file format
+static const uint32_t DataFileVersion = 4;
+
+//-------------------------
+std::string dataLayoutDescription(const Model& m)
+{
+    std::vector<const DataAccessor*> ordered(m.dataOffsetIndices().size() - 1, nullptr);
+    for (const auto& da : m.dataAccessors())
+        ordered[da->index()] = da;
+
+    std::string s;
+    auto append = [&s](uint64_t v) { s.append(reinterpret_cast<const char*>(&v), sizeof(v)); };
+
+    for (size_t i = 0; i < ordered.size(); ++i) {
+        const auto type = ordered[i]->data_accessor_type();
+        append(type.size());
+        s += type;
+        append(std::find(m.staticDataAccessors().begin(), m.staticDataAccessors().end(), ordered[i]) != m.staticDataAccessors().end());
+        append(ordered[i]->size());
+        append(ordered[i]->precision());
+        append(ordered[i]->recomputed());
+        append(m.dataOffsetIndices()[i + 1] - m.dataOffsetIndices()[i]);
+        for (auto j = m.dataOffsetIndices()[i]; j < m.dataOffsetIndices()[i + 1]; ++j)
+            append(m.dataOffsets()[j]);
+    }
+    return s;
+}
+
+//-------------------------
+DataFileHeader dataFileHeader(const Model& m, size_t n_points)
+{
+    const size_t page = MappedFile::pageSize();
+    const size_t doubles_per_page = page / sizeof(double);
+
+    DataFileHeader h;
+    std::memcpy(h.Magic, DataFileMagic, sizeof(DataFileMagic));
+    h.Version = DataFileVersion;
+    h.LayoutSize = dataLayoutDescription(m).size();
+    h.NPoints = n_points;
+    // round capacity up to whole pages, so that every column is page aligned
+    h.ColumnCapacity = std::max<size_t>((n_points + doubles_per_page - 1) / doubles_per_page, 1) * doubles_per_page;
+    h.NColumns = m.staticDataSize();
+    h.ColumnsOffset = (sizeof(h) + h.LayoutSize + page - 1) / page * page;
+    return h;
+}
+
+/// \return header of a data-set file, checking only its identifier and version
+/// \param data pointer to beginning of file
+/// \param n number of bytes available at data
+/// \param filename name of file, for error messages
+/// \param func name of calling function, for error messages
+static DataFileHeader readHeader(const char* data, size_t n, const std::string& filename, const std::string& func)
+{
+    DataFileHeader h;
+    if (n < sizeof(h))
+        throw exceptions::Exception(filename + " is too small", func);
+    std::memcpy(&h, data, sizeof(h));
+
+    if (std::memcmp(h.Magic, DataFileMagic, sizeof(DataFileMagic)) != 0)
+        throw exceptions::Exception(filename + " is not a YAP data file", func);
+
+    if (h.Version != DataFileVersion)
+        throw exceptions::Exception("unsupported version (" + std::to_string(h.Version) + ") of " + filename, func);
+
+    return h;
+}
+
+//-------------------------
+DataFileHeader readDataFileHeader(const char* data, size_t n, size_t file_size, const Model& m, const std::string& filename)
+{
+    const auto h = readHeader(data, n, filename, "readDataFileHeader");
+
+    const auto layout = dataLayoutDescription(m);
+    if (h.NColumns != m.staticDataSize() or h.LayoutSize != layout.size()
+            or sizeof(h) + layout.size() > n
+            or layout.compare(0, layout.size(), data + sizeof(h), h.LayoutSize) != 0)
+        throw exceptions::Exception("data layout of " + filename + " does not match model", "readDataFileHeader");
+
+    if (h.NPoints > h.ColumnCapacity or h.ColumnsOffset % sizeof(double) != 0
+            or h.offset(h.NColumns, 0) > file_size)
+        throw exceptions::Exception(filename + " is truncated or corrupt", "readDataFileHeader");
+
+    return h;
+}
+
+//-------------------------
+std::vector<bool> readRecomputedDataAccessors(const char* data, size_t n, const std::string& filename)
+{
+    const auto h = readHeader(data, n, filename, "readRecomputedDataAccessors");
+    if (sizeof(h) + h.LayoutSize > n)
+        throw exceptions::Exception(filename + " is truncated or corrupt", "readRecomputedDataAccessors");
+
+    // walk through description, as written by dataLayoutDescription
+    const char* p = data + sizeof(h);
+    const char* e = p + h.LayoutSize;
+    auto read = [&]() {
+        uint64_t v;
+        if (p + sizeof(v) > e)
+            throw exceptions::Exception(filename + " is truncated or corrupt", "readRecomputedDataAccessors");
+        std::memcpy(&v, p, sizeof(v));
+        p += sizeof(v);
+        return v;
+    };
+    auto skip = [&](uint64_t bytes) {
+        if (bytes > (uint64_t)(e - p))
+            throw exceptions::Exception(filename + " is truncated or corrupt", "readRecomputedDataAccessors");
+        p += bytes;
+    };
+
+    std::vector<bool> R;
+    while (p < e) {
+        // type, whether static, size, precision
+        skip(read());
+        read();
+        read();
+        read();
+        R.push_back(read() != 0);
+        // offsets
+        skip(read() * sizeof(uint64_t));
+    }
+    return R;
+}
+
+}
@@ -0,0 +1,240 @@
+#include "DataPartitionStream.h"
+
+#include "Exceptions.h"
+#include "logging.h"
+#include "Model.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace yap {
+
+//-------------------------
+DataPartitionStream::DataPartitionStream(const Model& m, const std::string& filename, size_t chunk_size, unsigned n_buffers) :
+    DataPartitionStream(m, filename, chunk_size, n_buffers, 0, std::numeric_limits<size_t>::max())
+{
+}
+
+//-------------------------
+DataPartitionStream::DataPartitionStream(const Model& m, const std::string& filename, size_t chunk_size, unsigned n_buffers,
+        size_t first, size_t last) :
+    DataPartitionBase(m.dataAccessors()),
+    Filename_(filename),
+    File_(-1),
+    ChunkSize_(chunk_size),
+    NBuffers_(n_buffers),
+    Buffers_(m, kColumnMajor),
+    Chunk_(0),
+    Read_(0),
+    Released_(0),
+    Reading_(false),
+    Stop_(false)
+{
+    if (ChunkSize_ == 0)
+        throw exceptions::Exception("chunk size is zero", "DataPartitionStream::DataPartitionStream");
+    if (NBuffers_ == 0)
+        throw exceptions::Exception("number of buffers is zero", "DataPartitionStream::DataPartitionStream");
+
+    File_ = ::open(Filename_.data(), O_RDONLY);
+    if (File_ < 0)
+        throw exceptions::Exception("could not open " + Filename_, "DataPartitionStream::DataPartitionStream");
+
+    try {
+        struct stat st;
+        if (::fstat(File_, &st) != 0)
+            throw exceptions::Exception("could not read size of " + Filename_, "DataPartitionStream::DataPartitionStream");
+
+        // read header, then header and layout description
+        DataFileHeader h;
+        if (::pread(File_, &h, sizeof(h), 0) != (ssize_t)sizeof(h) or sizeof(h) + h.LayoutSize > (size_t)st.st_size)
+            throw exceptions::Exception("could not read header of " + Filename_, "DataPartitionStream::DataPartitionStream");
+        std::vector<char> head(sizeof(h) + h.LayoutSize);
+        if (::pread(File_, head.data(), head.size(), 0) != (ssize_t)head.size())
+            throw exceptions::Exception("could not read header of " + Filename_, "DataPartitionStream::DataPartitionStream");
+
+        Header_ = readDataFileHeader(head.data(), head.size(), st.st_size, m, Filename_);
+
+        Last_ = std::min<size_t>(last, Header_.NPoints);
+        First_ = std::min(first, Last_);
+
+        // all buffers live in one vector, whose end is also the end of the stream;
+        // points are not moved once in use
+        Buffers_.addEmptyPoints(NBuffers_ * std::min(ChunkSize_, size()));
+
+        setBegin(DataPartitionBase::end(Buffers_));
+        setEnd(DataPartitionBase::end(Buffers_));
+
+        Reader_ = std::thread(&DataPartitionStream::readChunks, this);
+    } catch (...) {
+        ::close(File_);
+        throw;
+    }
+}
+
+//-------------------------
+DataPartitionStream::~DataPartitionStream()
+{
+    // reader thread must finish before buffers and file are released
+    stop();
+    ::close(File_);
+}
+
+//-------------------------
+void DataPartitionStream::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(Mutex_);
+        Stop_ = true;
+    }
+    Changed_.notify_all();
+    if (Reader_.joinable())
+        Reader_.join();
+}
+
+//-------------------------
+DataPartitionVector DataPartitionStream::create(const Model& m, const std::string& filename, unsigned n,
+        size_t chunk_size, unsigned n_buffers)
+{
+    if (n == 0)
+        throw exceptions::Exception("number of partitions is zero", "DataPartitionStream::create");
+
+    // first partition determines number of data points in file
+    std::unique_ptr<DataPartitionStream> first(new DataPartitionStream(m, filename, chunk_size, n_buffers));
+    const size_t N = first->size();
+
+    LOG(INFO) << "Partitioning data file of size " << N << " into " << n << " streams";
+
+    DataPartitionVector P;
+    P.reserve(n);
+
+    if (n == 1) {
+        P.push_back(std::move(first));
+        return P;
+    }
+    first.reset();
+
+    for (unsigned i = 0; i < n; ++i)
+        P.push_back(std::unique_ptr<DataPartitionBase>(new DataPartitionStream(m, filename, chunk_size, n_buffers,
+                    N * i / n, N * (i + 1) / n)));
+
+    return P;
+}
+
+//-------------------------
+void DataPartitionStream::read(size_t chunk)
+{
+    const size_t offset = (chunk % NBuffers_) * (Buffers_.points().size() / NBuffers_);
+    const size_t first = First_ + chunk * ChunkSize_;
+    const size_t bytes = chunkSize(chunk) * sizeof(double);
+
+    for (unsigned c = 0; c < Header_.NColumns; ++c) {
+        char* p = reinterpret_cast<char*>(Buffers_.StaticColumnData_ + c * Buffers_.StaticColumnCapacity_ + offset);
+        size_t n = 0;
+        while (n < bytes) {
+            auto r = ::pread(File_, p + n, bytes - n, Header_.offset(c, first) + n);
+            if (r <= 0)
+                throw exceptions::Exception("could not read " + Filename_, "DataPartitionStream::read");
+            n += r;
+        }
+    }
+}
+
+//-------------------------
+void DataPartitionStream::readChunks()
+{
+    std::unique_lock<std::mutex> lock(Mutex_);
+    while (true) {
+        // wait for a free buffer to read the next chunk into
+        Changed_.wait(lock, [&]() {return Stop_ or (!Exception_ and Read_ < std::min(Released_, nChunks()));});
+        if (Stop_)
+            return;
+
+        const size_t chunk = Read_;
+        Reading_ = true;
+        lock.unlock();
+
+        std::exception_ptr e;
+        try {
+            read(chunk);
+        } catch (...) {
+            e = std::current_exception();
+        }
+
+        lock.lock();
+        Reading_ = false;
+        if (e)
+            Exception_ = e;
+        else
+            ++Read_;
+        Changed_.notify_all();
+    }
+}
+
+//-------------------------
+void DataPartitionStream::release(size_t chunk)
+{
+    {
+        std::lock_guard<std::mutex> lock(Mutex_);
+        Released_ = chunk + 1 + NBuffers_;
+    }
+    Changed_.notify_all();
+}
+
+//-------------------------
+DataPointVector::iterator DataPartitionStream::waitFor(size_t chunk)
+{
+    {
+        std::unique_lock<std::mutex> lock(Mutex_);
+        Changed_.wait(lock, [&]() {return Read_ > chunk or Exception_;});
+        if (Read_ <= chunk)
+            std::rethrow_exception(Exception_);
+    }
+    auto it = DataPartitionBase::begin(Buffers_) + (chunk % NBuffers_) * (Buffers_.points().size() / NBuffers_);
+    ChunkEnd_ = it + chunkSize(chunk);
+    return it;
+}
+
+//-------------------------
+const DataIterator& DataPartitionStream::restart()
+{
+    {
+        // finish read of previous iteration, then read from first chunk again
+        std::unique_lock<std::mutex> lock(Mutex_);
+        Changed_.wait(lock, [&]() {return !Reading_;});
+        Read_ = 0;
+        Released_ = NBuffers_;
+        Exception_ = nullptr;
+    }
+    Changed_.notify_all();
+
+    Chunk_ = 0;
+    if (nChunks() == 0)
+        return setBegin(DataPartitionBase::end(Buffers_));
+
+    return setBegin(waitFor(0));
+}
+
+//-------------------------
+void DataPartitionStream::increment(DataIterator& it)
+{
+    auto& raw = rawIterator(it);
+    if (++raw != ChunkEnd_)
+        return;
+
+    // chunk is finished: reuse its buffer for a later chunk
+    release(Chunk_);
+
+    if (++Chunk_ < nChunks())
+        raw = waitFor(Chunk_);
+    else {
+        raw = DataPartitionBase::end(Buffers_);
+        // buffers no longer hold the first chunk
+        setBegin(raw);
+    }
+}
+
+}
@@ -5,19 +5,72 @@
 #include "FourMomenta.h"
 #include "Model.h"
 #include "StaticDataAccessor.h"
+#include "StatusManager.h"
 
 namespace yap {
 
 //-------------------------
 DataPoint::DataPoint(DataSet* dataSet) :
     ReportsModel(),
-    DataSet_(dataSet)
+    DataSet_(dataSet),
+    Base_(nullptr),
+    Stride_(1),
+    DynamicBase_(nullptr),
+    DynamicStride_(1),
+    RecomputedBase_(nullptr)
 {
     if (!DataSet_)
         throw exceptions::Exception("DataSet unset", "DataPoint::DataPoint");
-    Data_.resize(model()->dataAccessors().size());
-    for (auto da : model()->dataAccessors())
-        Data_[da->index()].assign(da->maxSymmetrizationIndex() + 1, std::vector<double>(da->size(), 0));
+    // storage for column-major data sets is set by the DataSet
+    if (DataSet_->layout() == kRowMajor) {
+        Data_.assign(model()->dataPointSize(), 0);
+        Base_ = Data_.data();
+        DynamicBase_ = Data_.data() + model()->staticDataSize();
+    }
+}
+
+//-------------------------
+DataPoint::DataPoint(const DataPoint& other) :
+    ReportsModel(other),
+    DataSet_(other.DataSet_),
+    Base_(nullptr),
+    Stride_(1),
+    DynamicBase_(nullptr),
+    DynamicStride_(1),
+    RecomputedBase_(nullptr)
+{
+    copyData(other);
+}
+
+//-------------------------
+DataPoint& DataPoint::operator=(const DataPoint& other)
+{
+    ReportsModel::operator=(other);
+    DataSet_ = other.DataSet_;
+    copyData(other);
+    return *this;
+}
+
+//-------------------------
+void DataPoint::copyData(const DataPoint& other)
+{
+    if (other.ownsData()) {
+        Data_ = other.Data_;
+        DynamicBase_ = Data_.data() + (other.DynamicBase_ - other.Base_);
+    } else {
+        // gather data out of the columns of a column-major data set,
+        // so that the copy does not alias the set's storage
+        const unsigned n_static = model()->staticDataSize();
+        Data_.resize(model()->dataPointSize());
+        for (unsigned i = 0; i < n_static; ++i)
+            Data_[i] = other.element(i);
+        for (unsigned i = n_static; i < Data_.size(); ++i)
+            Data_[i] = other.dynamicElement(i - n_static);
+        DynamicBase_ = Data_.data() + n_static;
+    }
+    Base_ = Data_.data();
+    Stride_ = 1;
+    DynamicStride_ = 1;
 }
 
 //-------------------------
@@ -32,17 +85,18 @@ void DataPoint::setFinalStateMomenta(const std::vector<FourVector<double> >& P,
     if (!model())
         throw exceptions::Exception("Model unset", "DataPoint::setFinalStateMomenta");
 
+    // static data shared with other data sets are copied before being written
+    if (!ownsData())
+        DataSet_->detachStaticColumns();
+
+    DataSet_->renewGeneration();
+
     model()->fourMomenta()->setFinalStateMomenta(*this, P, sm);
-    // call calculate on four momenta first
-    model()->fourMomenta()->calculate(*this, sm);
-    // call calculate on all other static data accessors in model
-    for (auto& sda : model()->dataAccessors()) {
-        // FourMomenta already calculated above
-        if (sda == model()->fourMomenta().get())
-            continue;
-        if (dynamic_cast<StaticDataAccessor*>(sda))
-            static_cast<StaticDataAccessor*>(sda)->calculate(*this, sm);
-    }
+    // call calculate on all stored static data accessors in model,
+    // in order of dependence (beginning with four momenta)
+    for (auto& sda : model()->staticDataAccessors())
+        if (!sda->recomputed())
+            sda->calculate(*this, sm);
 }
 
 //-------------------------
@@ -51,35 +105,121 @@ void DataPoint::setFinalStateMomenta(const std::vector<FourVector<double> >& P)
     setFinalStateMomenta(P, *DataSet_);
 }
 
+//-------------------------
+void DataPoint::throwNotRecomputed()
+{
+    throw exceptions::Exception("static data not stored are only available inside a RecomputedStaticData",
+                                "DataPoint::recomputedElement");
+}
+
+//-------------------------
+size_t DataPoint::nDataAccessors() const
+{
+    return model()->dataOffsetIndices().size() - 1;
+}
+
+//-------------------------
+size_t DataPoint::nSymIndices(unsigned i) const
+{
+    return model()->dataOffsetIndices()[i + 1] - model()->dataOffsetIndices()[i];
+}
+
+//-------------------------
+size_t DataPoint::nElements(unsigned i, unsigned j) const
+{
+    // all rows of a data accessor hold its full size
+    for (const auto& da : model()->dataAccessors())
+        if (da->index() == (int)i and j < nSymIndices(i))
+            return da->size();
+    throw exceptions::Exception("index out of range", "DataPoint::nElements");
+}
+
 //-------------------------
 bool equalStructure(const DataPoint& A, const DataPoint& B)
 {
-    if (A.Data_.size() != B.Data_.size())
+    if (A.ownsData() and B.ownsData() and A.Data_.size() != B.Data_.size())
+        return false;
+    return A.model() == B.model() or (A.model()->dataOffsets() == B.model()->dataOffsets()
+                                      and A.model()->dataOffsetIndices() == B.model()->dataOffsetIndices());
+}
+
+//-------------------------
+bool operator==(const DataPoint& lhs, const DataPoint& rhs)
+{
+    if (!equalStructure(lhs, rhs))
         return false;
-    for (size_t i = 0; i < A.Data_.size(); ++i) {
-        if (A.Data_[i].size() != B.Data_[i].size())
+
+    // compare single-precision elements as floats
+    const unsigned n = lhs.model()->singlePrecisionOffset();
+    const unsigned n_static = lhs.model()->staticDataSize();
+    if (lhs.ownsData() and rhs.ownsData() and n == n_static)
+        return lhs.Data_ == rhs.Data_;
+
+    for (unsigned i = 0; i < n; ++i)
+        if (lhs.element(i) != rhs.element(i))
+            return false;
+    for (unsigned i = 2 * n; i < 2 * n_static; ++i)
+        if (lhs.singleElement(i) != rhs.singleElement(i))
+            return false;
+    for (unsigned i = 0; i < lhs.model()->dataPointSize() - n_static; ++i)
+        if (lhs.dynamicElement(i) != rhs.dynamicElement(i))
             return false;
-        for (size_t j = 0; j < A.Data_[i].size(); ++j) {
-            if (A.Data_[i][j].size() != B.Data_[i][j].size())
-                return false;
-        }
-    }
     return true;
 }
 
 //-------------------------
 unsigned DataPoint::dataSize() const
 {
-    unsigned size = sizeof(Data_);
-    for (auto& v : Data_) {
-        size += sizeof(v);
-        for (auto& vv : v) {
-            size += sizeof(vv);
-            for (auto vvv : vv)
-                size += sizeof(vvv);
-        }
+    return sizeof(Data_) + model()->dataPointSize() * sizeof(double);
+}
+
+//-------------------------
+RecomputedStaticData::RecomputedStaticData(DataPoint& d, StatusManager& sm)
+{
+    // check before building a block, since this is called for every amplitude
+    if (d.model()->recomputedDataSize() > 0 and !d.RecomputedBase_)
+        recompute(DataPointBlock(1, &d), sm);
+}
+
+//-------------------------
+void RecomputedStaticData::recompute(const DataPointBlock& B, StatusManager& sm)
+{
+    if (B.empty() or B[0]->model()->recomputedDataSize() == 0)
+        return;
+
+    const Model* m = B[0]->model();
+    const size_t n = m->recomputedDataSize();
+
+    for (auto d : B)
+        if (!d->RecomputedBase_)
+            Points_.push_back(d);
+
+    if (Points_.empty())
+        return;
+
+    Values_.resize(n * Points_.size());
+    for (size_t i = 0; i < Points_.size(); ++i)
+        Points_[i]->RecomputedBase_ = Values_.data() + i * n;
+
+    try {
+        for (auto d : Points_)
+            // in order of dependence
+            for (auto& sda : m->staticDataAccessors())
+                if (sda->recomputed())
+                    sda->calculate(*d, sm);
+    } catch (...) {
+        release();
+        throw;
     }
-    return size;
 }
 
+//-------------------------
+void RecomputedStaticData::release()
+{
+    for (auto d : Points_)
+        d->RecomputedBase_ = nullptr;
+    Points_.clear();
 }
+
+}
+
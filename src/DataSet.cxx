@@ -1,27 +1,130 @@
 #include "DataSet.h"
 
+#include "CachedDataValue.h"
+#include "DataAccessor.h"
+#include "DataFile.h"
 #include "DataPoint.h"
 #include "Exceptions.h"
+#include "FourMomenta.h"
+#include "make_unique.h"
+#include "MappedFile.h"
 #include "Model.h"
+#include "StaticDataAccessor.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace yap {
 
 //-------------------------
-DataSet::DataSet(const Model& m) :
+/// write a buffer to a file at an offset, continuing after partial writes
+/// \return whether all bytes were written
+static bool writeAll(int fd, const void* buf, size_t n, size_t offset)
+{
+    const char* p = static_cast<const char*>(buf);
+    while (n > 0) {
+        auto written = ::pwrite(fd, p, n, offset);
+        if (written <= 0)
+            return false;
+        p += written;
+        n -= written;
+        offset += written;
+    }
+    return true;
+}
+
+/// last generation given to a data set
+static std::atomic<unsigned long> LastGeneration(0);
+
+//-------------------------
+DataSet::DataSet(const Model& m, DataLayout layout) :
     DataPartitionBlock(m.dataAccessors()),
     ReportsModel(),
-    Model_(&m)
+    Model_(&m),
+    NDataSets_(m.NDataSets_),
+    Layout_(layout),
+    ColumnCapacity_(0),
+    StaticColumnsShared_(false),
+    StaticColumnData_(nullptr),
+    StaticColumnCapacity_(0),
+    Generation_(++LastGeneration),
+    ComponentAmplitudesGeneration_(0),
+    ComponentAmplitudesLogPosition_(0)
 {
+    ++*NDataSets_;
+}
+
+//-------------------------
+DataSet::DataSet(const Model& m, const std::string& filename) :
+    DataPartitionBlock(m.dataAccessors()),
+    ReportsModel(),
+    Model_(&m),
+    NDataSets_(m.NDataSets_),
+    Layout_(kColumnMajor),
+    ColumnCapacity_(0),
+    StaticColumnsShared_(false),
+    Mapping_(std::make_shared<MappedFile>(filename)),
+    StaticColumnData_(nullptr),
+    StaticColumnCapacity_(0),
+    Generation_(++LastGeneration),
+    ComponentAmplitudesGeneration_(0),
+    ComponentAmplitudesLogPosition_(0)
+{
+    const auto h = readDataFileHeader(Mapping_->data(), Mapping_->size(), Mapping_->size(), m, filename);
+
+    StaticColumnCapacity_ = h.ColumnCapacity;
+    StaticColumnData_ = reinterpret_cast<double*>(Mapping_->data() + h.ColumnsOffset);
+
+    // static columns are never written to, so they stay shared with the page cache;
+    // protect them if they are page aligned on this machine
+    const size_t page = MappedFile::pageSize();
+    const size_t length = h.NColumns * StaticColumnCapacity_ * sizeof(double);
+    if (h.ColumnsOffset % page == 0 and length % page == 0)
+        Mapping_->protect(h.ColumnsOffset, length);
+
+    ColumnCapacity_ = h.NPoints;
+    Columns_.assign((m.dataPointSize() - m.staticDataSize()) * ColumnCapacity_, 0);
+
+    DataPoints_.reserve(h.NPoints);
+    for (size_t i = 0; i < h.NPoints; ++i)
+        DataPoints_.emplace_back(this);
+    assertDataPointOwnership();
+
+    // static data have already been calculated
+    for (const auto& sda : m.staticDataAccessors())
+        set(*sda, kCalculated);
+
+    ++*NDataSets_;
 }
 
 //-------------------------
 DataSet::DataSet(const DataSet& other) :
     DataPartitionBlock(other),
     ReportsModel(),
-    DataPoints_(other.DataPoints_),
-    Model_(other.Model_)
+    Model_(other.Model_),
+    NDataSets_(other.NDataSets_),
+    Layout_(other.Layout_),
+    Columns_(other.Columns_),
+    ColumnCapacity_(other.ColumnCapacity_),
+    StaticColumns_((other.shareStaticColumns(), other.StaticColumns_)),
+    StaticColumnsShared_((bool)StaticColumns_),
+    Mapping_(other.Mapping_),
+    StaticColumnData_(other.StaticColumnData_),
+    StaticColumnCapacity_(other.StaticColumnCapacity_),
+    Indices_(other.Indices_),
+    Generation_(++LastGeneration),
+    ComponentAmplitudesGeneration_(0),
+    ComponentAmplitudesLogPosition_(0)
 {
-    assertDataPointOwnership();
+    copyPoints(other);
+    ++*NDataSets_;
 }
 
 //-------------------------
@@ -29,18 +132,64 @@ DataSet::DataSet(DataSet&& other) :
     DataPartitionBlock(std::move(other)),
     ReportsModel(),
     DataPoints_(std::move(other.DataPoints_)),
-    Model_(std::move(other.Model_))
+    Model_(other.Model_),
+    NDataSets_(other.NDataSets_),
+    Layout_(other.Layout_),
+    Columns_(std::move(other.Columns_)),
+    ColumnCapacity_(other.ColumnCapacity_),
+    StaticColumns_(std::move(other.StaticColumns_)),
+    StaticColumnsShared_(other.StaticColumnsShared_.load()),
+    Mapping_(std::move(other.Mapping_)),
+    StaticColumnData_(other.StaticColumnData_),
+    StaticColumnCapacity_(other.StaticColumnCapacity_),
+    Indices_(std::move(other.Indices_)),
+    Generation_(other.Generation_),
+    ComponentAmplitudes_(std::move(other.ComponentAmplitudes_)),
+    ComponentAmplitudesGeneration_(other.ComponentAmplitudesGeneration_),
+    ComponentAmplitudesLogPosition_(other.ComponentAmplitudesLogPosition_)
 {
+    // the moved-from data set is counted until destroyed
+    ++*NDataSets_;
+    other.renewGeneration();
+    other.releaseColumns();
     assertDataPointOwnership();
 }
 
+//-------------------------
+DataSet::~DataSet()
+{
+    --*NDataSets_;
+}
+
+//-------------------------
+void DataSet::setModel(const Model* m)
+{
+    if (m->NDataSets_ != NDataSets_) {
+        ++*m->NDataSets_;
+        --*NDataSets_;
+        NDataSets_ = m->NDataSets_;
+    }
+    Model_ = m;
+}
+
 //-------------------------
 DataSet& DataSet::operator=(const DataSet& other)
 {
     DataPartitionBlock::operator=(other);
-    Model_ = other.Model_;
-    DataPoints_ = other.DataPoints_;
-    assertDataPointOwnership();
+    setModel(other.Model_);
+    Layout_ = other.Layout_;
+    Columns_ = other.Columns_;
+    ColumnCapacity_ = other.ColumnCapacity_;
+    other.shareStaticColumns();
+    StaticColumns_ = other.StaticColumns_;
+    StaticColumnsShared_ = (bool)StaticColumns_;
+    Mapping_ = other.Mapping_;
+    StaticColumnData_ = other.StaticColumnData_;
+    StaticColumnCapacity_ = other.StaticColumnCapacity_;
+    Indices_ = other.Indices_;
+    renewGeneration();
+    ComponentAmplitudes_.reset();
+    copyPoints(other);
     return *this;
 }
 
@@ -48,8 +197,23 @@ DataSet& DataSet::operator=(const DataSet& other)
 DataSet& DataSet::operator=(DataSet&& other)
 {
     DataPartitionBlock::operator=(std::move(other));
-    Model_ = std::move(other.Model_);
+    setModel(other.Model_);
     DataPoints_ = std::move(other.DataPoints_);
+    Layout_ = other.Layout_;
+    Columns_ = std::move(other.Columns_);
+    ColumnCapacity_ = other.ColumnCapacity_;
+    StaticColumns_ = std::move(other.StaticColumns_);
+    StaticColumnsShared_ = other.StaticColumnsShared_.load();
+    Mapping_ = std::move(other.Mapping_);
+    StaticColumnData_ = other.StaticColumnData_;
+    StaticColumnCapacity_ = other.StaticColumnCapacity_;
+    Indices_ = std::move(other.Indices_);
+    Generation_ = other.Generation_;
+    ComponentAmplitudes_ = std::move(other.ComponentAmplitudes_);
+    ComponentAmplitudesGeneration_ = other.ComponentAmplitudesGeneration_;
+    ComponentAmplitudesLogPosition_ = other.ComponentAmplitudesLogPosition_;
+    other.renewGeneration();
+    other.releaseColumns();
     assertDataPointOwnership();
     return *this;
 }
@@ -59,7 +223,21 @@ void swap(DataSet& A, DataSet& B)
 {
     std::swap(static_cast<DataPartitionBlock&>(A), static_cast<DataPartitionBlock&>(B));
     std::swap(A.Model_, B.Model_);
+    std::swap(A.NDataSets_, B.NDataSets_);
     std::swap(A.DataPoints_, B.DataPoints_);
+    std::swap(A.Layout_, B.Layout_);
+    std::swap(A.Columns_, B.Columns_);
+    std::swap(A.ColumnCapacity_, B.ColumnCapacity_);
+    std::swap(A.StaticColumns_, B.StaticColumns_);
+    A.StaticColumnsShared_ = B.StaticColumnsShared_.exchange(A.StaticColumnsShared_);
+    std::swap(A.Mapping_, B.Mapping_);
+    std::swap(A.StaticColumnData_, B.StaticColumnData_);
+    std::swap(A.StaticColumnCapacity_, B.StaticColumnCapacity_);
+    std::swap(A.Indices_, B.Indices_);
+    std::swap(A.Generation_, B.Generation_);
+    std::swap(A.ComponentAmplitudes_, B.ComponentAmplitudes_);
+    std::swap(A.ComponentAmplitudesGeneration_, B.ComponentAmplitudesGeneration_);
+    std::swap(A.ComponentAmplitudesLogPosition_, B.ComponentAmplitudesLogPosition_);
     A.assertDataPointOwnership();
     B.assertDataPointOwnership();
 }
@@ -67,8 +245,120 @@ void swap(DataSet& A, DataSet& B)
 //-------------------------
 void DataSet::assertDataPointOwnership()
 {
-    for (auto& d : DataPoints_)
-        d.DataSet_ = this;
+    for (size_t i = 0; i < DataPoints_.size(); ++i) {
+        DataPoints_[i].DataSet_ = this;
+        if (Layout_ == kColumnMajor)
+            DataPoints_[i].setStorage(StaticColumnData_ + (Indices_.empty() ? i : Indices_[i]), StaticColumnCapacity_,
+                                      Columns_.data() + i, ColumnCapacity_);
+    }
+}
+
+//-------------------------
+void DataSet::renewGeneration()
+{
+    Generation_ = ++LastGeneration;
+}
+
+//-------------------------
+void DataSet::releaseColumns()
+{
+    DataPoints_.clear();
+    Columns_.clear();
+    ColumnCapacity_ = 0;
+    StaticColumns_.reset();
+    StaticColumnsShared_ = false;
+    Mapping_.reset();
+    StaticColumnData_ = nullptr;
+    StaticColumnCapacity_ = 0;
+    Indices_.clear();
+}
+
+//-------------------------
+void DataSet::copyPoints(const DataSet& other)
+{
+    if (Layout_ == kRowMajor)
+        DataPoints_ = other.DataPoints_;
+    else {
+        // points of column-major data sets hold no data of their own
+        DataPoints_.clear();
+        DataPoints_.reserve(other.DataPoints_.size());
+        for (size_t i = 0; i < other.DataPoints_.size(); ++i)
+            DataPoints_.emplace_back(this);
+    }
+    assertDataPointOwnership();
+}
+
+//-------------------------
+void DataSet::reserveColumns(size_t n)
+{
+    // static columns shared with other data sets or a file are copied before being written to
+    if (n <= ColumnCapacity_ and staticColumnsUnique())
+        return;
+
+    // grow geometrically to keep repeated addEmptyPoint calls cheap
+    const size_t capacity = (n <= ColumnCapacity_) ? ColumnCapacity_ : std::max(n, 2 * ColumnCapacity_);
+    const size_t n_static = model()->staticDataSize();
+    const size_t n_points = DataPoints_.size();
+
+    // gather static columns, in order of data points
+    auto static_columns = std::make_shared<std::vector<double> >(n_static * capacity, 0);
+    for (size_t i = 0; i < n_static; ++i) {
+        const double* old_column = StaticColumnData_ + i * StaticColumnCapacity_;
+        auto column = static_columns->begin() + i * capacity;
+        if (Indices_.empty())
+            std::copy(old_column, old_column + n_points, column);
+        else
+            for (size_t j = 0; j < n_points; ++j)
+                column[j] = old_column[Indices_[j]];
+    }
+
+    if (capacity != ColumnCapacity_) {
+        const size_t n_dynamic = model()->dataPointSize() - n_static;
+        std::vector<double> columns(n_dynamic * capacity, 0);
+        for (size_t i = 0; i < n_dynamic; ++i)
+            std::copy(Columns_.begin() + i * ColumnCapacity_,
+                      Columns_.begin() + i * ColumnCapacity_ + n_points,
+                      columns.begin() + i * capacity);
+        Columns_.swap(columns);
+        ColumnCapacity_ = capacity;
+    }
+
+    StaticColumns_ = static_columns;
+    StaticColumnsShared_ = false;
+    Mapping_.reset();
+    StaticColumnData_ = StaticColumns_->data();
+    StaticColumnCapacity_ = capacity;
+    Indices_.clear();
+
+    assertDataPointOwnership();
+}
+
+//-------------------------
+void DataSet::reserve(size_t n)
+{
+    DataPoints_.reserve(n);
+    if (Layout_ == kColumnMajor)
+        reserveColumns(n);
+}
+
+//-------------------------
+double* DataSet::column(const CachedDataValue& cdv, unsigned index, unsigned sym_index)
+{
+    if (Layout_ != kColumnMajor)
+        throw exceptions::Exception("DataSet is not column major", "DataSet::column");
+    if (index >= cdv.size())
+        throw exceptions::Exception("index out of range", "DataSet::column");
+    if (cdv.owner()->recomputed())
+        throw exceptions::Exception("CachedDataValue is recomputed rather than stored", "DataSet::column");
+    if (cdv.owner()->precision() != kDoublePrecision)
+        throw exceptions::Exception("CachedDataValue is not stored in double precision", "DataSet::column");
+
+    unsigned i = model()->dataOffset(cdv.owner()->index(), sym_index) + cdv.position() + index;
+    if (!cdv.owner()->isStatic())
+        return Columns_.data() + i * ColumnCapacity_;
+    if (!Indices_.empty())
+        throw exceptions::Exception("static columns of a subset are shared with its parent", "DataSet::column");
+    return StaticColumnData_ + i * StaticColumnCapacity_;
 }
 
 //-------------------------
@@ -83,9 +373,17 @@ void DataSet::addEmptyPoint()
     if (!model())
         throw exceptions::Exception("Model unset or deleted", "DataSet::add");
 
+    if (Layout_ == kColumnMajor)
+        reserveColumns(DataPoints_.size() + 1);
+
     DataPoints_.emplace_back(this);
+    renewGeneration();
     auto& d = DataPoints_.back();
 
+    if (Layout_ == kColumnMajor)
+        d.setStorage(StaticColumnData_ + DataPoints_.size() - 1, StaticColumnCapacity_,
+                     Columns_.data() + DataPoints_.size() - 1, ColumnCapacity_);
+
     if (!consistent(d))
         throw exceptions::Exception("produced inconsistent data point", "Model::addDataPoint");
 }
@@ -93,6 +391,7 @@ void DataSet::addEmptyPoint()
 //-------------------------
 void DataSet::addEmptyPoints(size_t n)
 {
+    reserve(DataPoints_.size() + n);
     for (size_t i = 0; i < n; ++i)
         addEmptyPoint();
 }
@@ -104,6 +403,183 @@ void DataSet::add(const std::vector<FourVector<double> >& P)
     DataPoints_.back().setFinalStateMomenta(P);
 }
 
+//-------------------------
+void DataSet::addPoints(const std::vector<FourVector<double> >& P, unsigned n_threads)
+{
+    addPoints(P, nullptr, n_threads);
+}
+
+//-------------------------
+void DataSet::addPoints(const std::vector<FourVector<double> >& P, ThreadPool& pool)
+{
+    addPoints(P, &pool, pool.size());
+}
+
+//-------------------------
+void DataSet::addPoints(const std::vector<FourVector<double> >& P, ThreadPool* pool, unsigned n_threads)
+{
+    if (!model())
+        throw exceptions::Exception("Model unset or deleted", "DataSet::addPoints");
+
+    const size_t n_fsp = model()->finalStateParticles().size();
+    if (n_fsp == 0 or P.size() % n_fsp != 0)
+        throw exceptions::Exception("number of four momenta (" + std::to_string(P.size())
+                                    + ") is not a multiple of number of final-state particles (" + std::to_string(n_fsp) + ")",
+                                    "DataSet::addPoints");
+
+    const size_t first = DataPoints_.size();
+    const size_t n = P.size() / n_fsp;
+    if (n == 0)
+        return;
+
+    // number of data points each accessor is called on in turn
+    const size_t block_size = 256;
+
+    try {
+
+        // add all points first, so that no storage is reallocated while calculating
+        addEmptyPoints(n);
+
+        // without a pool, make one with a partition per thread over its range of the new points
+        DataPartitionVector partitions;
+        std::unique_ptr<ThreadPool> own_pool;
+        if (!pool) {
+            if (n_threads == 0)
+                n_threads = std::max(std::thread::hardware_concurrency(), 1u);
+            n_threads = std::min<size_t>(n_threads, (n + block_size - 1) / block_size);
+            for (unsigned t = 0; t < n_threads; ++t)
+                partitions.push_back(std::make_unique<DataPartitionBlock>(*this, DataPoints_.begin() + first + n * t / n_threads,
+                                     DataPoints_.begin() + first + n * (t + 1) / n_threads));
+            own_pool = std::make_unique<ThreadPool>(partitions);
+            pool = own_pool.get();
+        }
+
+        // each worker calculates a contiguous range of points,
+        // keeping its statuses in its partition
+        pool->run([&](DataPartitionBase & sm, unsigned t) {
+            std::vector<FourVector<double> > p(n_fsp);
+            const size_t end = first + n * (t + 1) / n_threads;
+            for (size_t b = first + n * t / n_threads; b < end; b += block_size) {
+                const size_t e = std::min(b + block_size, end);
+                for (size_t i = b; i < e; ++i) {
+                    std::copy(P.begin() + (i - first) * n_fsp, P.begin() + (i - first + 1) * n_fsp, p.begin());
+                    model()->fourMomenta()->setFinalStateMomenta(DataPoints_[i], p, sm);
+                }
+                for (auto& sda : model()->staticDataAccessors())
+                    if (!sda->recomputed())
+                        for (size_t i = b; i < e; ++i)
+                            sda->calculate(DataPoints_[i], sm);
+            }
+        });
+
+    } catch (...) {
+        // leave the data set as it was
+        DataPoints_.erase(DataPoints_.begin() + first, DataPoints_.end());
+        throw;
+    }
+
+    renewGeneration();
+
+    // stored static data are calculated for all points; no point's
+    // parameter-dependent data are, since the new points have none yet
+    for (const auto& da : model()->dataAccessors())
+        set(*da, kUncalculated);
+    for (const auto& sda : model()->staticDataAccessors())
+        if (!sda->recomputed())
+            set(*sda, kCalculated);
+}
+
+//-------------------------
+void DataSet::write(const std::string& filename) const
+{
+    if (!model())
+        throw exceptions::Exception("Model unset or deleted", "DataSet::write");
+
+    const size_t n = DataPoints_.size();
+    const auto layout = dataLayoutDescription(*model());
+    const auto h = dataFileHeader(*model(), n);
+
+    int fd = ::open(filename.data(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        throw exceptions::Exception("could not open " + filename, "DataSet::write");
+
+    bool ok = writeAll(fd, &h, sizeof(h), 0) and writeAll(fd, layout.data(), layout.size(), sizeof(h));
+
+    std::vector<double> column(n);
+    for (unsigned c = 0; c < h.NColumns; ++c) {
+        for (size_t i = 0; i < n; ++i)
+            column[i] = DataPoints_[i].element(c);
+        ok = ok and writeAll(fd, column.data(), n * sizeof(double), h.offset(c, 0));
+    }
+
+    // set full size, including the unused end of the last column
+    ok = ok and ::ftruncate(fd, h.offset(h.NColumns, 0)) == 0;
+    ok = (::close(fd) == 0) and ok;
+
+    if (!ok)
+        throw exceptions::Exception("could not write " + filename, "DataSet::write");
+}
+
+//-------------------------
+DataSet DataSet::subset(const std::vector<size_t>& indices) const
+{
+    if (!model())
+        throw exceptions::Exception("Model unset or deleted", "DataSet::subset");
+    for (auto i : indices)
+        if (i >= DataPoints_.size())
+            throw exceptions::Exception("index out of range", "DataSet::subset");
+
+    DataSet S(*model(), Layout_);
+    S.DataPoints_.reserve(indices.size());
+
+    if (Layout_ == kRowMajor) {
+        // row-major data points own their data
+        for (auto i : indices)
+            S.DataPoints_.push_back(DataPoints_[i]);
+    } else {
+        shareStaticColumns();
+        S.StaticColumns_ = StaticColumns_;
+        S.StaticColumnsShared_ = (bool)StaticColumns_;
+        S.Mapping_ = Mapping_;
+        S.StaticColumnData_ = StaticColumnData_;
+        S.StaticColumnCapacity_ = StaticColumnCapacity_;
+
+        // indices into a subset are translated into indices into the static columns
+        S.Indices_.reserve(indices.size());
+        for (auto i : indices)
+            S.Indices_.push_back(Indices_.empty() ? i : Indices_[i]);
+
+        S.ColumnCapacity_ = indices.size();
+        S.Columns_.assign((model()->dataPointSize() - model()->staticDataSize()) * S.ColumnCapacity_, 0);
+
+        // points of column-major data sets hold no data of their own
+        for (size_t i = 0; i < indices.size(); ++i)
+            S.DataPoints_.emplace_back(&S);
+    }
+    S.assertDataPointOwnership();
+
+    // static data have already been calculated
+    for (const auto& sda : model()->staticDataAccessors())
+        S.set(*sda, kCalculated);
+
+    return S;
+}
+
+//-------------------------
+DataSet DataSet::resample(const std::vector<unsigned>& multiplicities) const
+{
+    if (multiplicities.size() != DataPoints_.size())
+        throw exceptions::Exception("number of multiplicities (" + std::to_string(multiplicities.size())
+                                    + ") does not match number of data points (" + std::to_string(DataPoints_.size()) + ")",
+                                    "DataSet::resample");
+
+    std::vector<size_t> indices;
+    indices.reserve(std::accumulate(multiplicities.begin(), multiplicities.end(), size_t(0)));
+    for (size_t i = 0; i < multiplicities.size(); ++i)
+        indices.insert(indices.end(), multiplicities[i], i);
+    return subset(indices);
+}
+
 //-------------------------
 bool operator==(const DataSet& lhs, const DataSet& rhs)
 { return lhs.Model_ == rhs.Model_ and lhs.DataPoints_ == rhs.DataPoints_; }
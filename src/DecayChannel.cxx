@@ -14,6 +14,8 @@
 #include "SpinAmplitudeCache.h"
 #include "StatusManager.h"
 
+#include <algorithm>
+
 namespace yap {
 
 //-------------------------
@@ -176,13 +178,18 @@ void DecayChannel::addSpinAmplitude(std::shared_ptr<SpinAmplitude> sa)
     for (auto& pc : particleCombinations())
         sa -> addParticleCombination(pc);
 
+    TotalAmplitudes_.resize(sa->initialTwoJ() + 1);
+    ProjectionTerms_.resize(sa->initialTwoJ() + 1);
+
     // create vector of amplitude pairs, one for each spin projection in the SpinAmplitude
     AmplitudePairMap apM;
     for (auto& two_m : sa->twoM()) {
 
+        auto& totAmp = TotalAmplitudes_[spin_projection_index(two_m, sa->initialTwoJ())];
+
         // add TotalAmplitude for two_m if needed
-        if (TotalAmplitudes_.find(two_m) == TotalAmplitudes_.end())
-            TotalAmplitudes_[two_m] = ComplexCachedDataValue::create(this);
+        if (!totAmp)
+            totAmp = ComplexCachedDataValue::create(this);
 
         // insert new AmplitudePair into map, retaining the added Amplitude pair
         auto ap = (apM.insert(std::make_pair(two_m, std::move(AmplitudePair(this))))).first->second;
@@ -197,12 +204,16 @@ void DecayChannel::addSpinAmplitude(std::shared_ptr<SpinAmplitude> sa)
                     ap.Fixed->addDependency(DaughterCachedDataValue(c, i));
 
         // add to TotalAmplitudes_[two_m]'s dependencies
-        TotalAmplitudes_[two_m]->addDependency(ap.Free);
-        TotalAmplitudes_[two_m]->addDependency(ap.Fixed);
+        totAmp->addDependency(ap.Free);
+        totAmp->addDependency(ap.Fixed);
     }
 
     // add to Amplitudes_
-    Amplitudes_.insert(std::make_pair(sa, std::move(apM)));
+    const auto& apM_ = Amplitudes_.insert(std::make_pair(sa, std::move(apM))).first->second;
+
+    // add to ProjectionTerms_, pointing into Amplitudes_
+    for (const auto& ap_kv : apM_)
+        ProjectionTerms_[spin_projection_index(ap_kv.first, sa->initialTwoJ())].push_back({sa.get(), &ap_kv.second});
 }
 
 //-------------------------
@@ -231,23 +242,45 @@ ComplexParameterVector DecayChannel::freeAmplitudes()
 
 //-------------------------
 std::complex<double> DecayChannel::amplitude(DataPoint& d, const std::shared_ptr<ParticleCombination>& pc, int two_m, StatusManager& sm) const
+{
+    std::vector<std::vector<std::complex<double> > > D(Daughters_.size());
+    return amplitude(d, pc, spin_projection_index(two_m, DecayingParticle_->quantumNumbers().twoJ()), symmetrizationIndex(pc), D, sm);
+}
+
+//-------------------------
+std::vector<std::complex<double> > DecayChannel::amplitudes(DataPoint& d, const std::shared_ptr<ParticleCombination>& pc, StatusManager& sm) const
 {
     const unsigned symIndex = symmetrizationIndex(pc);
 
-    auto& totAmp = TotalAmplitudes_.at(two_m);
+    // daughter amplitudes are shared by all spin projections of the decaying particle
+    std::vector<std::vector<std::complex<double> > > D(Daughters_.size());
+
+    std::vector<std::complex<double> > A(TotalAmplitudes_.size(), Complex_0);
+    for (unsigned i_m = 0; i_m < TotalAmplitudes_.size(); ++i_m)
+        if (TotalAmplitudes_[i_m])
+            A[i_m] = amplitude(d, pc, i_m, symIndex, D, sm);
+    return A;
+}
+
+//-------------------------
+std::complex<double> DecayChannel::amplitude(DataPoint& d, const std::shared_ptr<ParticleCombination>& pc, unsigned i_m, unsigned symIndex,
+        std::vector<std::vector<std::complex<double> > >& D, StatusManager& sm) const
+{
+    auto& totAmp = TotalAmplitudes_[i_m];
 
     if (sm.status(*totAmp, symIndex) != kUncalculated) {
         FDEBUG("\nused cached fixed amplitude for " << *this << " for " << *pc << " : " << totAmp->value(d, symIndex));
         return totAmp->value(d, symIndex);
     }
 
+    const int two_m = 2 * (int)i_m - (int)DecayingParticle_->quantumNumbers().twoJ();
+
     // sum over L-S combinations
     // LOOP_0 = sum_{L, S} BlattWeisskopf_L * free_amp(L, S, m) * LOOP_1
-    // kvA = pair< shared_ptr<SpinAmplitude>, vector<AmplitudePair> >
     std::complex<double> A = Complex_0;
-    for (auto& kvA : Amplitudes_) {
+    for (const auto& t : ProjectionTerms_[i_m]) {
 
-        auto ap = kvA.second.at(two_m); // AmplitudePair for spin projection m
+        const auto& ap = *t.Amplitudes; // AmplitudePair for spin projection m
 
         // if already calculated
 
@@ -260,17 +293,17 @@ std::complex<double> DecayChannel::amplitude(DataPoint& d, const std::shared_ptr
 
         // else calculate
 
-        auto sa = kvA.first; // SpinAmplitude
+        const auto& sa = t.SpinAmp; // SpinAmplitude
 
         DEBUG("DecayChannel::amplitude :: Calculating " << *this << " for two_m = " << two_m << " and pc = " << *pc << " for sp.amp. = " << *sa);
 
-        // get map of SpinProjectionPair's to cached spin amplitudes
-        const auto& m = sa->amplitudes().at(two_m);
+        // get vector of SpinProjectionPair's and cached spin amplitudes
+        const auto& m = sa->amplitudes(two_m);
         const auto sa_symIndex = sa->symmetrizationIndex(pc);
 
         // sum over daughter spin projection combinations (m1, m2)
         // LOOP_1 = sum_{m1, m2} SpinAmplitude_{L, S, m, m1, m2}(d) * amp_{daughter1}(m1) * amp_{daughter2}(m2)
-        // kvM = pair <SpinProjectionPair, ComplexCachedDataValue>
+        // kvM = pair <SpinProjectionPair, ComplexCachedDataValue*>
         std::complex<double> a = Complex_0;
         for (auto& kvM : m) {
             // retrieve cached spin amplitude from data point
@@ -278,10 +311,14 @@ std::complex<double> DecayChannel::amplitude(DataPoint& d, const std::shared_ptr
 
             FDEBUG("amp(" << sa_symIndex << " of " << kvM.second->owner()->symmetrizationIndices().size()  << ") := " << amp);
 
-            // loop over daughters, multiplying by their amplitudes for their spin projections
+            // loop over daughters, multiplying by their amplitudes for their spin projections,
+            // calculating the amplitudes for all of a daughter's spin projections on first use
             const auto& spp = kvM.first; // SpinProjectionPair
-            for (size_t i = 0; i < spp.size(); ++i)
-                amp *= Daughters_[i]->amplitude(d, pc->daughters()[i], spp[i], sm);
+            for (size_t i = 0; i < spp.size(); ++i) {
+                if (D[i].empty())
+                    D[i] = Daughters_[i]->amplitudes(d, pc->daughters()[i], sm);
+                amp *= D[i][spin_projection_index(spp[i], Daughters_[i]->quantumNumbers().twoJ())];
+            }
 
             FDEBUG("amp -> " << amp);
 
@@ -314,6 +351,88 @@ std::complex<double> DecayChannel::amplitude(DataPoint& d, const std::shared_ptr
     return A;
 }
 
+//-------------------------
+void DecayChannel::calculate(const DataPointBlock& B, StatusManager& sm) const
+{
+    const unsigned twoJ = DecayingParticle_->quantumNumbers().twoJ();
+
+    // fixed amplitude and total amplitude, by data point
+    std::vector<std::complex<double> > a(B.size());
+    std::vector<std::complex<double> > A(B.size());
+
+    for (const auto& kv : symmetrizationIndices()) {
+
+        const auto& pc = kv.first;
+        const unsigned symIndex = kv.second;
+
+        if (std::none_of(TotalAmplitudes_.begin(), TotalAmplitudes_.end(),
+        [&](const std::shared_ptr<ComplexCachedDataValue>& t) {return t and sm.status(*t, symIndex) == kUncalculated;}))
+            continue;
+
+        // amplitudes of daughters, by daughter, spin projection index, and data point
+        std::vector<std::vector<std::vector<std::complex<double> > > > D(Daughters_.size());
+        for (size_t i = 0; i < Daughters_.size(); ++i) {
+            D[i].assign(Daughters_[i]->quantumNumbers().twoJ() + 1, std::vector<std::complex<double> >(B.size(), Complex_0));
+            for (size_t p = 0; p < B.size(); ++p) {
+                auto d_i = Daughters_[i]->amplitudes(*B[p], pc->daughters()[i], sm);
+                for (size_t m = 0; m < d_i.size() and m < D[i].size(); ++m)
+                    D[i][m][p] = d_i[m];
+            }
+        }
+
+        for (unsigned i_m = 0; i_m < TotalAmplitudes_.size(); ++i_m) {
+
+            const auto& totAmp = TotalAmplitudes_[i_m];
+            if (!totAmp or sm.status(*totAmp, symIndex) != kUncalculated)
+                continue;
+
+            const int two_m = 2 * (int)i_m - (int)twoJ;
+
+            std::fill(A.begin(), A.end(), Complex_0);
+
+            for (const auto& t : ProjectionTerms_[i_m]) {
+
+                const auto& ap = *t.Amplitudes;
+
+                if (sm.status(*ap.Fixed, symIndex) == kUncalculated) {
+
+                    const auto& sa = t.SpinAmp;
+                    const auto sa_symIndex = sa->symmetrizationIndex(pc);
+
+                    // sum over daughter spin projection combinations of
+                    // spin amplitude times daughter amplitudes
+                    std::fill(a.begin(), a.end(), Complex_0);
+                    for (auto& kvM : sa->amplitudes(two_m)) {
+                        const auto& spp = kvM.first;
+                        for (size_t p = 0; p < B.size(); ++p) {
+                            auto amp = kvM.second->value(*B[p], sa_symIndex);
+                            for (size_t i = 0; i < spp.size(); ++i)
+                                amp *= D[i][spin_projection_index(spp[i], Daughters_[i]->quantumNumbers().twoJ())][p];
+                            a[p] += amp;
+                        }
+                    }
+
+                    // multiply by Blatt-Weisskopf factor for orbital angular momentum L
+                    const auto& bw = DecayingParticle_->BlattWeisskopfs_.at(sa->L());
+                    for (size_t p = 0; p < B.size(); ++p)
+                        a[p] *= bw->amplitude(*B[p], pc, sm);
+
+                    for (size_t p = 0; p < B.size(); ++p)
+                        ap.Fixed->setValue(a[p], *B[p], symIndex, sm);
+                }
+
+                // add into total amplitude
+                const auto free = ap.Free->value();
+                for (size_t p = 0; p < B.size(); ++p)
+                    A[p] += free * ap.Fixed->value(*B[p], symIndex);
+            }
+
+            for (size_t p = 0; p < B.size(); ++p)
+                totAmp->setValue(A[p], *B[p], symIndex, sm);
+        }
+    }
+}
+
 //-------------------------
 bool DecayChannel::consistent() const
 {
@@ -431,8 +550,9 @@ SpinAmplitudeVector DecayChannel::spinAmplitudes()
 CachedDataValueSet DecayChannel::cachedDataValuesItDependsOn()
 {
     CachedDataValueSet S;
-    for (auto& kv : TotalAmplitudes_)
-        S.insert(kv.second);
+    for (auto& a : TotalAmplitudes_)
+        if (a)
+            S.insert(a);
     return S;
 }
 
@@ -4,8 +4,10 @@
 #include "container_utils.h"
 #include "Model.h"
 #include "logging.h"
+#include "spin.h"
 #include "StatusManager.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <memory>
 
@@ -16,7 +18,8 @@ DecayingParticle::DecayingParticle(const QuantumNumbers& q, double mass, std::st
     AmplitudeComponent(),
     Particle(q, mass, name),
     DataAccessor(&ParticleCombination::equivUpAndDown),
-    RadialSize_(std::make_shared<RealParameter>(radialSize))
+    RadialSize_(std::make_shared<RealParameter>(radialSize)),
+    Amplitudes_(q.twoJ() + 1)
 {
 }
 
@@ -26,7 +29,7 @@ std::complex<double> DecayingParticle::amplitude(DataPoint& d, const std::shared
     unsigned symIndex = symmetrizationIndex(pc);
 
     // get cached amplitude object for spin projection two_m
-    auto A = Amplitudes_.at(two_m);
+    const auto& A = Amplitudes_[spin_projection_index(two_m, quantumNumbers().twoJ())];
 
     if (sm.status(*A, symIndex) == kUncalculated) {
 
@@ -49,6 +52,75 @@ std::complex<double> DecayingParticle::amplitude(DataPoint& d, const std::shared
     return A->value(d, symIndex);
 }
 
+//-------------------------
+std::vector<std::complex<double> > DecayingParticle::amplitudes(DataPoint& d, const std::shared_ptr<ParticleCombination>& pc, StatusManager& sm) const
+{
+    unsigned symIndex = symmetrizationIndex(pc);
+
+    std::vector<std::complex<double> > A(Amplitudes_.size(), Complex_0);
+
+    // return cached amplitudes if all spin projections are already calculated
+    if (std::none_of(Amplitudes_.begin(), Amplitudes_.end(),
+    [&](const std::shared_ptr<ComplexCachedDataValue>& a) {return a and sm.status(*a, symIndex) == kUncalculated;})) {
+        for (size_t i = 0; i < Amplitudes_.size(); ++i)
+            if (Amplitudes_[i])
+                A[i] = Amplitudes_[i]->value(d, symIndex);
+        DEBUG("DecayingParticle::amplitudes - used cached amplitudes for " << name() << " " << *pc);
+        return A;
+    }
+
+    // sum up DecayChannel::amplitudes over each channel,
+    // traversing each channel once for all spin projections
+    for (auto& c : channels())
+        if (c->hasParticleCombination(pc)) {
+            auto a_c = c->amplitudes(d, pc, sm);
+            for (size_t i = 0; i < a_c.size() and i < A.size(); ++i)
+                A[i] += a_c[i];
+        }
+
+    for (size_t i = 0; i < Amplitudes_.size(); ++i)
+        if (Amplitudes_[i] and sm.status(*Amplitudes_[i], symIndex) == kUncalculated)
+            Amplitudes_[i]->setValue(A[i], d, symIndex, sm);
+
+    DEBUG("DecayingParticle::amplitudes - calculated amplitudes for " << name() << " " << *pc);
+    return A;
+}
+
+//-------------------------
+void DecayingParticle::calculate(const DataPointBlock& B, StatusManager& sm) const
+{
+    for (const auto& kv : BlattWeisskopfs_)
+        kv.second->calculate(B, sm);
+
+    for (const auto& c : channels())
+        c->calculate(B, sm);
+
+    // sum channels' total amplitudes for each spin projection
+    std::vector<std::complex<double> > A(B.size());
+
+    for (const auto& kv : symmetrizationIndices()) {
+        for (size_t i_m = 0; i_m < Amplitudes_.size(); ++i_m) {
+
+            const auto& amp = Amplitudes_[i_m];
+            if (!amp or sm.status(*amp, kv.second) != kUncalculated)
+                continue;
+
+            std::fill(A.begin(), A.end(), Complex_0);
+            for (const auto& c : channels()) {
+                if (!c->hasParticleCombination(kv.first) or i_m >= c->TotalAmplitudes_.size() or !c->TotalAmplitudes_[i_m])
+                    continue;
+                const auto& tot = c->TotalAmplitudes_[i_m];
+                const unsigned c_symIndex = c->symmetrizationIndex(kv.first);
+                for (size_t p = 0; p < B.size(); ++p)
+                    A[p] += tot->value(*B[p], c_symIndex);
+            }
+
+            for (size_t p = 0; p < B.size(); ++p)
+                amp->setValue(A[p], *B[p], kv.second, sm);
+        }
+    }
+}
+
 //-------------------------
 bool DecayingParticle::consistent() const
 {
@@ -140,12 +212,15 @@ std::shared_ptr<DecayChannel> DecayingParticle::addChannel(std::shared_ptr<Decay
     }
 
     // Add DecayChannel's TotalAmplitude's as dependencies for this object's Amplitudes
-    // by spin projection (key in TotalAmplitudes_)
-    for (auto& kv : Channels_.back()->TotalAmplitudes_) {
+    // by spin projection (index in TotalAmplitudes_)
+    const auto& TA = Channels_.back()->TotalAmplitudes_;
+    for (size_t i = 0; i < TA.size() and i < Amplitudes_.size(); ++i) {
+        if (!TA[i])
+            continue;
         // if spin projection not yet in Amplitudes_, add it
-        if (Amplitudes_.find(kv.first) == Amplitudes_.end())
-            Amplitudes_[kv.first] = ComplexCachedDataValue::create(this);
-        Amplitudes_[kv.first]->addDependency(kv.second);
+        if (!Amplitudes_[i])
+            Amplitudes_[i] = ComplexCachedDataValue::create(this);
+        Amplitudes_[i]->addDependency(TA[i]);
     }
 
     FLOG(INFO) << *Channels_.back() << " with N(PC) = " << Channels_.back()->particleCombinations().size();
@@ -233,8 +308,9 @@ void DecayingParticle::printDecayChainLevel(int level) const
 CachedDataValueSet DecayingParticle::cachedDataValuesItDependsOn()
 {
     CachedDataValueSet S;
-    for (auto& kv : Amplitudes_)
-        S.insert(kv.second);
+    for (auto& a : Amplitudes_)
+        if (a)
+            S.insert(a);
     return S;
 }
 
@@ -0,0 +1,140 @@
+#include "DependencyGraph.h"
+
+#include "CachedDataValue.h"
+#include "Exceptions.h"
+#include "Parameter.h"
+#include "ParticleCombination.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace yap {
+
+//-------------------------
+DependencyGraph::DependencyGraph(const DataAccessorSet& sDA, std::shared_ptr<ParameterChangeLog> log)
+    : ChangeLog_(log)
+{
+    if (!ChangeLog_)
+        throw exceptions::Exception("ParameterChangeLog unset", "DependencyGraph::DependencyGraph");
+
+    // order DataAccessor's by index
+    std::vector<DataAccessor*> das(sDA.size(), nullptr);
+    for (auto da : sDA) {
+        if (da->index() < 0 or da->index() >= (int)das.size())
+            throw exceptions::Exception("DataAccessor index out of range", "DependencyGraph::DependencyGraph");
+        das[da->index()] = da;
+    }
+
+    // number unsorted nodes by (DataAccessor, CachedDataValue, symmetrization index)
+    // and CachedDataValue's by (DataAccessor, CachedDataValue)
+    std::vector<std::vector<unsigned> > first_node(das.size());
+    std::vector<Node> nodes;
+    std::vector<const CachedDataValue*> values;
+    for (size_t i = 0; i < das.size(); ++i) {
+        auto cdvs = das[i]->cachedDataValues();
+        first_node[i].resize(cdvs.size());
+        unsigned first_value = values.size();
+        values.resize(first_value + cdvs.size());
+        for (const auto& c : cdvs) {
+            values[first_value + c->index()] = c.get();
+            first_node[i][c->index()] = nodes.size();
+            for (int s = 0; s <= das[i]->maxSymmetrizationIndex(); ++s)
+                nodes.push_back({(unsigned)i, (unsigned)c->index(), (unsigned)s, first_value + c->index()});
+        }
+    }
+
+    auto node = [&](const CachedDataValue & c, unsigned s) {return first_node[c.owner()->index()][c.index()] + s;};
+
+    // collect dependencies of unsorted nodes
+    std::vector<std::vector<unsigned> > deps(nodes.size());
+    for (const auto da : das)
+        for (const auto& kv : da->symmetrizationIndices()) {
+            const auto& pc = kv.first;
+            for (const auto& cdv : da->cachedDataValues()) {
+                auto& D = deps[node(*cdv, kv.second)];
+
+                for (const auto& c : cdv->cachedDataValueDependencies()) {
+                    if (c->owner() == da)
+                        D.push_back(node(*c, kv.second));
+                    else if (c->owner()->hasParticleCombination(pc))
+                        D.push_back(node(*c, c->owner()->symmetrizationIndex(pc)));
+                }
+
+                for (const auto& dcdv : cdv->daughterCachedDataValueDependencies()) {
+                    const auto& dpc = pc->daughters()[dcdv.Daughter];
+                    if (dcdv.CDV->owner() != da and !dcdv.CDV->owner()->hasParticleCombination(dpc))
+                        continue;
+                    D.push_back(node(*dcdv.CDV, dcdv.CDV->owner()->symmetrizationIndex(dpc)));
+                }
+            }
+        }
+
+    // sort topologically by depth-first search
+    enum : char {unvisited, visiting, visited};
+    std::vector<char> state(nodes.size(), unvisited);
+    std::vector<unsigned> order;
+    order.reserve(nodes.size());
+
+    std::function<void(unsigned)> visit = [&](unsigned n) {
+        if (state[n] == visited)
+            return;
+        if (state[n] == visiting)
+            throw exceptions::Exception("cyclic dependency between CachedDataValue's", "DependencyGraph::DependencyGraph");
+        state[n] = visiting;
+        for (auto d : deps[n])
+            visit(d);
+        state[n] = visited;
+        order.push_back(n);
+    };
+
+    for (unsigned n = 0; n < nodes.size(); ++n)
+        visit(n);
+
+    // position of each unsorted node in sorted order
+    std::vector<unsigned> position(nodes.size());
+    for (unsigned i = 0; i < order.size(); ++i)
+        position[order[i]] = i;
+
+    // store sorted nodes and their edges
+    Nodes_.reserve(nodes.size());
+    EdgeOffsets_.reserve(nodes.size() + 1);
+    for (auto n : order) {
+        Nodes_.push_back(nodes[n]);
+        EdgeOffsets_.push_back(Edges_.size());
+
+        // remove duplicates
+        std::sort(deps[n].begin(), deps[n].end());
+        deps[n].erase(std::unique(deps[n].begin(), deps[n].end()), deps[n].end());
+
+        for (auto d : deps[n])
+            Edges_.push_back(position[d]);
+    }
+    EdgeOffsets_.push_back(Edges_.size());
+
+    NCachedDataValues_ = values.size();
+
+    // index parameters and the CachedDataValue's depending on them
+    std::vector<std::vector<unsigned> > dependents;
+    for (unsigned c = 0; c < values.size(); ++c)
+        for (const auto& p : values[c]->parameterDependencies()) {
+            auto it = ParameterIndices_.emplace(p.get(), Parameters_.size());
+            if (it.second) {
+                Parameters_.push_back(p.get());
+                dependents.push_back({});
+            }
+            dependents[it.first->second].push_back(c);
+        }
+
+    DependentOffsets_.reserve(Parameters_.size() + 1);
+    for (const auto& d : dependents) {
+        DependentOffsets_.push_back(Dependents_.size());
+        Dependents_.insert(Dependents_.end(), d.begin(), d.end());
+    }
+    DependentOffsets_.push_back(Dependents_.size());
+
+    // have parameters record their changes
+    for (auto p : Parameters_)
+        p->addChangeLog(ChangeLog_);
+}
+
+}
@@ -47,21 +47,13 @@ std::complex<double> Flatte::amplitude(DataPoint& d, const std::shared_ptr<Parti
 {
     unsigned symIndex = symmetrizationIndex(pc);
 
-    if (sm.status(*WidthTerm_, symIndex) == kUncalculated) {
-        auto w = Complex_0;
-        // sum of coupling * complex-breakup-momentum
-        for (const auto& fc : FlatteChannels_)
-            w += fc.Coupling->value() * std::sqrt(std::complex<double>(model()->fourMomenta()->m2(d, pc) / 4. - pow(fc.Mass->value(), 2), 0));
-        // sum * i * 2 / mass
-        w *= Complex_i * 2. / model()->fourMomenta()->m(d, pc);
-        WidthTerm_->setValue(w, d, symIndex, sm);
-    }
+    if (sm.status(*WidthTerm_, symIndex) == kUncalculated)
+        WidthTerm_->setValue(widthTerm(d, pc), d, symIndex, sm);
 
     // recalculate, cache, & return, if necessary
     if (sm.status(*T(), symIndex) == kUncalculated) {
 
-        // T = 1 / (M^2 - m^2 - width-term)
-        std::complex<double> t = 1. / (pow(mass()->value(), 2) - model()->fourMomenta()->m2(d, pc) - WidthTerm_->value(d, symIndex));
+        std::complex<double> t = calc(d, pc);
 
         T()->setValue(t, d, symIndex, sm);
 
@@ -75,6 +67,35 @@ std::complex<double> Flatte::amplitude(DataPoint& d, const std::shared_ptr<Parti
     return T()->value(d, symIndex);
 }
 
+//-------------------------
+void Flatte::calculate(const DataPointBlock& B, StatusManager& sm) const
+{
+    for (const auto& kv : symmetrizationIndices())
+        if (sm.status(*WidthTerm_, kv.second) == kUncalculated)
+            for (auto d : B)
+                WidthTerm_->setValue(widthTerm(*d, kv.first), *d, kv.second, sm);
+
+    MassShapeWithNominalMass::calculate(B, sm);
+}
+
+//-------------------------
+std::complex<double> Flatte::calc(const DataPoint& d, const std::shared_ptr<ParticleCombination>& pc) const
+{
+    // T = 1 / (M^2 - m^2 - width-term)
+    return 1. / (pow(mass()->value(), 2) - model()->fourMomenta()->m2(d, pc) - WidthTerm_->value(d, symmetrizationIndex(pc)));
+}
+
+//-------------------------
+std::complex<double> Flatte::widthTerm(const DataPoint& d, const std::shared_ptr<ParticleCombination>& pc) const
+{
+    auto w = Complex_0;
+    // sum of coupling * complex-breakup-momentum
+    for (const auto& fc : FlatteChannels_)
+        w += fc.Coupling->value() * std::sqrt(std::complex<double>(model()->fourMomenta()->m2(d, pc) / 4. - pow(fc.Mass->value(), 2), 0));
+    // sum * i * 2 / mass
+    return w * Complex_i * 2. / model()->fourMomenta()->m(d, pc);
+}
+
 //-------------------------
 bool Flatte::consistent() const
 {
@@ -35,6 +35,14 @@ void FourMomenta::setFinalStateMomenta(DataPoint& d, const std::vector<FourVecto
         P_->setValue(P[i], d, FSPIndices_[i], sm);
 }
 
+//-------------------------
+void FourMomenta::setStoragePolicy(StoragePolicy p)
+{
+    if (p != kStore)
+        throw exceptions::Exception("four momenta must be stored", "FourMomenta::setStoragePolicy");
+    StaticDataAccessor::setStoragePolicy(p);
+}
+
 //-------------------------
 unsigned FourMomenta::addParticleCombination(std::shared_ptr<ParticleCombination> pc)
 {
@@ -8,17 +8,20 @@
 #include "ParticleCombination.h"
 #include "ThreeVector.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace yap {
 
 //-------------------------
 HelicityAngles::HelicityAngles(Model* m) :
     StaticDataAccessor(m, &ParticleCombination::equivUpAndDown),
-    Phi_(RealCachedDataValue::create(this)),
-    Theta_(RealCachedDataValue::create(this))
+    CosTheta_(RealCachedDataValue::create(this)),
+    ExpIPhi_(ComplexCachedDataValue::create(this))
 {
     /// \todo add check that FourMomenta exists, after changing to return shared_ptr
-    Phi_->addDependency(model()->fourMomenta()->momentum());
-    Theta_->addDependency(model()->fourMomenta()->momentum());
+    CosTheta_->addDependency(model()->fourMomenta()->momentum());
+    ExpIPhi_->addDependency(model()->fourMomenta()->momentum());
 }
 
 //-------------------------
@@ -31,12 +34,12 @@ void HelicityAngles::calculate(DataPoint& d, StatusManager& sm) const
     // \todo allow for designating the boost that takes from the data frame to the lab frame (possibly event dependent)
     for (auto& kv : symmetrizationIndices())
         if (kv.first->indices().size() == model()->finalStateParticles().size())
-            calculateAngles(d, kv.first, model()->coordinateSystem(), unitMatrix<double, 4>(), sm);
+            calculateAngles(d, kv.first, model()->coordinateSystem(), LorentzBoost<double>(), sm);
 }
 
 //-------------------------
 void HelicityAngles::calculateAngles(DataPoint& d, const std::shared_ptr<ParticleCombination>& pc,
-                                     const CoordinateSystem<double, 3>& C, const FourMatrix<double>& boosts,
+                                     const CoordinateSystem<double, 3>& C, const LorentzBoost<double>& boosts,
                                      StatusManager& sm) const
 {
     // terminate recursion
@@ -50,7 +53,7 @@ void HelicityAngles::calculateAngles(DataPoint& d, const std::shared_ptr<Particl
     const auto cP = helicityFrame(boosts * P, C);
 
     // calculate boost from data frame into pc rest frame
-    const auto b = lorentzTransformation(-P);
+    const auto b = lorentzBoost(-P);
 
     const unsigned symIndex = symmetrizationIndex(pc);
 
@@ -60,12 +63,21 @@ void HelicityAngles::calculateAngles(DataPoint& d, const std::shared_ptr<Particl
         const auto p = b * model()->fourMomenta()->p(d, daughter);
 
         // if unset, set angles of parent to first daughter's
-        if (sm.status(*Phi_, symIndex) == kUncalculated or sm.status(*Theta_, symIndex) == kUncalculated) {
+        if (sm.status(*CosTheta_, symIndex) == kUncalculated or sm.status(*ExpIPhi_, symIndex) == kUncalculated) {
+
+            // components of p in reference frame, whose axes are unit vectors
+            const auto v = vect<double>(p);
+            const double x = v * cP[0];
+            const double y = v * cP[1];
+            const double z = v * cP[2];
 
-            const auto phi_theta = angles<double>(vect<double>(p), cP);
+            // cos(theta), corrected for rounding just outside [-1, 1]
+            const double r = std::sqrt(x * x + y * y + z * z);
+            CosTheta_->setValue(std::max(-1., std::min(1., z / r)), d, symIndex, sm);
 
-            Phi_->setValue(phi_theta[0], d, symIndex, sm);
-            Theta_->setValue(phi_theta[1], d, symIndex, sm);
+            // exp(i phi), with phi = 0 if p is along the z axis
+            const double rho = std::sqrt(x * x + y * y);
+            ExpIPhi_->setValue(rho > 0 ? std::complex<double>(x / rho, y / rho) : Complex_1, d, symIndex, sm);
         }
 
         // continue down the decay tree
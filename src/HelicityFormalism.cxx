@@ -2,10 +2,16 @@
 
 #include "ClebschGordan.h"
 #include "HelicityAngles.h"
+#include "MathUtilities.h"
+#include "logging.h"
 #include "Model.h"
 #include "spin.h"
+#include "StatusManager.h"
 #include "WignerD.h"
 
+#include <cmath>
+#include <vector>
+
 namespace yap {
 
 //-------------------------
@@ -33,13 +39,68 @@ HelicitySpinAmplitude::HelicitySpinAmplitude(unsigned two_J, unsigned two_j1, un
 
     if (Coefficients_.empty())
         throw exceptions::Exception("no valid nonzero Clebsch-Gordan coefficients stored", "HelicitySpinAmplitude::HelicitySpinAmplitude");
+
+    // cache d-matrix tables now, before any threads evaluate them
+    dMatrix::cache(initialTwoJ());
 }
 
 //-------------------------
 void HelicitySpinAmplitude::setDependencies(std::shared_ptr<CachedDataValue> a)
 {
-    a->addDependency(model()->helicityAngles()->phi());
-    a->addDependency(model()->helicityAngles()->theta());
+    a->addDependency(model()->helicityAngles()->cosTheta());
+    a->addDependency(model()->helicityAngles()->expIPhi());
+}
+
+//-------------------------
+void HelicitySpinAmplitude::calculate(DataPoint& d, StatusManager& sm) const
+{
+    // set all amplitudes Uncalculated
+    sm.set(*this, kUncalculated);
+
+    // d-matrix elements, reused for all particle combinations
+    std::vector<double> dJ;
+
+    // loop over particle combinations
+    for (auto& pc : particleCombinations()) {
+
+        unsigned symIndex = symmetrizationIndex(pc);
+
+        // helicity angles
+        const auto expIPhi = model()->helicityAngles()->expIPhi(d, pc);
+        const auto cosTheta = model()->helicityAngles()->cosTheta(d, pc);
+
+        // calculate all elements of d^J(theta) at once
+        dMatrix::calculate(initialTwoJ(), cosTheta, dJ);
+
+        // phase = exp(i M phi), starting from M = -J;
+        // with exp(i phi / 2) from the principal square root, since phi is in [-pi, pi]
+        auto phase = is_odd(initialTwoJ()) ? std::conj(std::sqrt(expIPhi)) : Complex_1;
+        for (unsigned i = 0; i < initialTwoJ() / 2; ++i)
+            phase *= std::conj(expIPhi);
+
+        // loop over parent spin projections
+        for (int two_M = -(int)initialTwoJ(); two_M <= (int)initialTwoJ(); two_M += 2, phase *= expIPhi) {
+
+            // conj(D^J_(M, m1 - m2)(phi, theta, 0)) = exp(i M phi) * d^J_(M, m1 - m2)(theta)
+            const auto* dJ_M = &dJ[spin_projection_index(two_M, initialTwoJ()) * (initialTwoJ() + 1)];
+
+            // loop over daughter spin projection pairs and amplitudes
+            for (auto& spp_a : amplitudes(two_M))
+
+                // if yet uncalculated
+                if (sm.status(*spp_a.second, symIndex) == kUncalculated) {
+
+                    const auto& spp = spp_a.first; // SpinProjectionPair of daughters
+
+                    // d^J_MN vanishes for |N| > J
+                    auto val = std::abs(spp[0] - spp[1]) > (int)initialTwoJ() ? Complex_0
+                               : phase * dJ_M[spin_projection_index(spp[0] - spp[1], initialTwoJ())] * Coefficients_.at(spp[0]).at(spp[1]);
+                    FDEBUG(*this << " := " << val << ", for " << *pc << " for " << two_M << " -> " << spp[0] << " + " << spp[1]);
+
+                    spp_a.second->setValue(val, d, symIndex, sm);
+                }
+        }
+    }
 }
 
 //-------------------------
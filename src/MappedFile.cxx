@@ -0,0 +1,59 @@
+#include "MappedFile.h"
+
+#include "Exceptions.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace yap {
+
+//-------------------------
+MappedFile::MappedFile(const std::string& filename) :
+    Data_(nullptr),
+    Size_(0)
+{
+    int fd = ::open(filename.data(), O_RDONLY);
+    if (fd < 0)
+        throw exceptions::Exception("could not open " + filename, "MappedFile::MappedFile");
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 or st.st_size == 0) {
+        ::close(fd);
+        throw exceptions::Exception("could not read size of " + filename, "MappedFile::MappedFile");
+    }
+    Size_ = st.st_size;
+
+    // private mapping: written pages are copied, the file is left unchanged
+    void* p = ::mmap(nullptr, Size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    // the mapping holds its own reference to the file
+    ::close(fd);
+
+    if (p == MAP_FAILED)
+        throw exceptions::Exception("could not map " + filename, "MappedFile::MappedFile");
+    Data_ = static_cast<char*>(p);
+}
+
+//-------------------------
+MappedFile::~MappedFile()
+{
+    ::munmap(Data_, Size_);
+}
+
+//-------------------------
+void MappedFile::protect(size_t offset, size_t length)
+{
+    if (offset % pageSize() != 0 or offset + length > Size_)
+        throw exceptions::Exception("invalid range", "MappedFile::protect");
+    if (length > 0 and ::mprotect(Data_ + offset, length, PROT_READ) != 0)
+        throw exceptions::Exception("could not protect range", "MappedFile::protect");
+}
+
+//-------------------------
+size_t MappedFile::pageSize()
+{
+    return ::sysconf(_SC_PAGESIZE);
+}
+
+}
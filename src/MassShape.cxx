@@ -1,9 +1,11 @@
 #include "MassShape.h"
 
+#include "CalculationStatus.h"
 #include "Exceptions.h"
 #include "logging.h"
 #include "ParticleCombination.h"
 #include "Resonance.h"
+#include "StatusManager.h"
 
 namespace yap {
 
@@ -14,6 +16,19 @@ MassShape::MassShape() :
     T_(ComplexCachedDataValue::create(this))
 {}
 
+//-------------------------
+void MassShape::calculate(const DataPointBlock& B, StatusManager& sm) const
+{
+    for (const auto& kv : symmetrizationIndices()) {
+
+        if (sm.status(*T(), kv.second) != kUncalculated)
+            continue;
+
+        for (auto d : B)
+            T()->setValue(calc(*d, kv.first), *d, kv.second, sm);
+    }
+}
+
 //-------------------------
 bool MassShape::consistent() const
 {
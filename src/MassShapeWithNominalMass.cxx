@@ -8,7 +8,7 @@
 namespace yap {
 
 //-------------------------
-std::shared_ptr<RealParameter> MassShapeWithNominalMass::mass()
+const std::shared_ptr<RealParameter>& MassShapeWithNominalMass::mass()
 {
     if (!resonance())
         throw exceptions::ResonanceUnset("MassShapeWithNominalMass::mass");
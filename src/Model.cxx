@@ -1,25 +1,45 @@
 #include "Model.h"
 
+#include "ComponentAmplitudes.h"
 #include "Constants.h"
+#include "DataFile.h"
+#include "DecayChannel.h"
 #include "DecayingParticle.h"
 #include "FinalStateParticle.h"
 #include "FourMomenta.h"
 #include "HelicityAngles.h"
 #include "logging.h"
+#include "MappedFile.h"
 #include "MassAxes.h"
 #include "MeasuredBreakupMomenta.h"
 #include "SpinAmplitudeCache.h"
+#include "StaticDataAccessor.h"
+#include "ThreadPool.h"
+#include "WorkStealingScheduler.h"
 
 /// \todo Find better place for this
 INITIALIZE_EASYLOGGINGPP
 
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <limits>
 #include <future>
+#include <map>
+#include <tuple>
 
 namespace yap {
 
 //-------------------------
 Model::Model(std::unique_ptr<SpinAmplitudeCache> SAC) :
     CoordinateSystem_(ThreeAxes),
+    DataPointSize_(0),
+    StaticDataSize_(0),
+    SinglePrecisionOffset_(0),
+    RecomputedDataSize_(0),
+    NDataSets_(std::make_shared<std::atomic<unsigned> >(0)),
+    ParameterChangeLog_(std::make_shared<ParameterChangeLog>()),
+    UseComponentAmplitudes_(false),
     FourMomenta_(std::make_shared<FourMomenta>(this)),
     MeasuredBreakupMomenta_(std::make_shared<MeasuredBreakupMomenta>(this)),
     HelicityAngles_(std::make_shared<HelicityAngles>(this))
@@ -40,6 +60,9 @@ std::complex<double> Model::amplitude(DataPoint& d, int two_m, StatusManager& sm
     if (!InitialStateParticle_)
         throw exceptions::Exception("Initial state unset", "Model::amplitude");
 
+    // recompute static data that are not stored
+    RecomputedStaticData R(d, sm);
+
     std::complex<double> a = Complex_0;
 
     // sum up ISP's amplitude over each particle combination
@@ -57,41 +80,147 @@ std::complex<double> Model::amplitude(DataPoint& d, StatusManager& sm) const
     if (!InitialStateParticle_)
         throw exceptions::Exception("Initial state unset", "Model::amplitude");
 
+    // recompute static data that are not stored
+    RecomputedStaticData R(d, sm);
+
     std::complex<double> a = Complex_0;
 
-    for (int two_m = -InitialStateParticle_->quantumNumbers().twoJ(); two_m <= (int)InitialStateParticle_->quantumNumbers().twoJ(); two_m += 2) {
-        for (auto& kv : InitialStateParticle_->symmetrizationIndices()) {
-            FDEBUG("calculating for two_m = " << two_m << " and pc = " << *kv.first);
-            a += InitialStateParticle_->amplitude(d, kv.first, two_m, sm);
-        }
+    // sum up ISP's amplitudes over each particle combination,
+    // calculating all spin projections in one traversal of the decay tree
+    for (auto& kv : InitialStateParticle_->symmetrizationIndices()) {
+        FDEBUG("calculating for all two_m and pc = " << *kv.first);
+        for (const auto& a_m : InitialStateParticle_->amplitudes(d, kv.first, sm))
+            a += a_m;
     }
 
     return a;
 }
 
+//-------------------------
+void Model::blockAmplitudes(DataPartitionBase& D, const StatusManager& global,
+                            const std::function<void(const std::vector<std::complex<double> >&)>& reduce) const
+{
+    // number of data points evaluated together
+    const size_t block_size = 128;
+
+    DataPointBlock B;
+    B.reserve(block_size);
+    std::vector<std::complex<double> > A;
+    A.reserve(block_size);
+
+    auto evaluate = [&]() {
+        D.inheritCalculationStatuses(global);
+
+        // recompute static data that are not stored, once for the block
+        RecomputedStaticData R(B, D);
+
+        // the points of a block share their statuses: evaluate each node
+        // over the whole block, daughters before their parents
+        for (auto dp : DecayingParticles_)
+            dp->calculate(B, D);
+
+        // sum up initial-state particle's (now cached) amplitudes
+        for (auto d : B)
+            A.push_back(amplitude(*d, D));
+
+        reduce(A);
+        A.clear();
+        B.clear();
+    };
+
+    for (DataIterator d = D.restart(); d != D.end(); ++d) {
+        B.push_back(&*d);
+        if (B.size() == block_size or D.endsBlock(d))
+            evaluate();
+    }
+    if (!B.empty())
+        evaluate();
+}
+
+//-------------------------
+void Model::amplitudes(DataPartitionBase& D, const StatusManager& global, std::vector<std::complex<double> >& A) const
+{
+    A.clear();
+
+    blockAmplitudes(D, global, [&](const std::vector<std::complex<double> >& a) {A.insert(A.end(), a.begin(), a.end());});
+
+    D.detachCalculationStatuses();
+}
+
 //-------------------------
 double Model::partialSumOfLogsOfSquaredAmplitudes(DataPartitionBase* D, const StatusManager& global) const
 {
+    double L = logsOfSquaredAmplitudes(*D, global);
+    finishPartition(*D);
+    return L;
+}
+
+//-------------------------
+double Model::logsOfSquaredAmplitudes(DataPartitionBase& D, const StatusManager& global) const
+{
+    // reduce amplitudes block by block, so that memory use
+    // does not grow with the size of the partition
     double L = 0;
+    blockAmplitudes(D, global, [&](const std::vector<std::complex<double> >& A) {
+        for (const auto& a : A)
+            L += log(norm(a));
+    });
 
-    // loop over data points in partition
-    for (DataIterator d = D->begin(); d != D->end(); ++d) {
-        DEBUG("- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - ");
-        D->copyCalculationStatuses(global);
-        L += log(norm(amplitude(*d, *D)));
-    }
+    return L;
+}
+
+//-------------------------
+void Model::finishPartition(DataPartitionBase& D)
+{
+    D.detachCalculationStatuses();
 
     // set all variable statuses to Unchanged
-    D->setAll(kUnchanged);
+    D.setAll(kUnchanged);
+}
 
-    return L;
+//-------------------------
+void Model::setUseComponentAmplitudes(bool use)
+{
+    UseComponentAmplitudes_ = use;
+}
+
+//-------------------------
+const ComponentAmplitudes* Model::componentAmplitudes(DataSet& DS) const
+{
+    if (!UseComponentAmplitudes_ or !linearInFreeAmplitudes())
+        return nullptr;
+
+    // components are kept by the data set, so that evaluating over
+    // several data sets (e.g., data and MC) does not recalculate them
+    bool current = DS.ComponentAmplitudes_ and DS.Model_ == this
+                   and DS.ComponentAmplitudesGeneration_ == DS.generation()
+                   and ParameterChangeLog_->holds(DS.ComponentAmplitudesLogPosition_);
+
+    // changes to free amplitudes are accounted for in evaluating the components;
+    // changes to any other parameter require recalculating them
+    if (current) {
+        const auto& free = DS.ComponentAmplitudes_->freeAmplitudes();
+        for (auto p = ParameterChangeLog_->begin(DS.ComponentAmplitudesLogPosition_); p != ParameterChangeLog_->end() and current; ++p)
+            current = std::any_of(free.begin(), free.end(), [&](const std::shared_ptr<ComplexParameter>& a) {return a.get() == *p;});
+    }
+
+    if (!current) {
+        DS.ComponentAmplitudes_ = std::make_shared<ComponentAmplitudes>(*this, DS);
+        DS.ComponentAmplitudesGeneration_ = DS.generation();
+    }
+    DS.ComponentAmplitudesLogPosition_ = ParameterChangeLog_->position();
+
+    return DS.ComponentAmplitudes_.get();
 }
 
 //-------------------------
 double Model::sumOfLogsOfSquaredAmplitudes(DataSet& DS) const
 {
+    if (auto CA = componentAmplitudes(DS))
+        return CA->sumOfLogsOfSquaredAmplitudes();
+
     // update data set's calculation statuses
-    DS.updateCalculationStatuses(dataAccessors());
+    DS.updateCalculationStatuses(dependencyGraph());
 
     return partialSumOfLogsOfSquaredAmplitudes(&DS, StatusManager(DS));
 }
@@ -101,8 +230,11 @@ double Model::sumOfLogsOfSquaredAmplitudes(DataSet& DS, DataPartitionVector& DP)
     if (DP.empty())
         throw exceptions::Exception("DataPartitionVector is empty", "Model::sumOfLogsOfSquaredAmplitudes");
 
+    if (auto CA = componentAmplitudes(DS))
+        return CA->sumOfLogsOfSquaredAmplitudes();
+
     // update global calculation statuses (managed by data set)
-    DS.updateCalculationStatuses(dataAccessors());
+    DS.updateCalculationStatuses(dependencyGraph());
 
     double log_L = 0;
 
@@ -116,7 +248,8 @@ double Model::sumOfLogsOfSquaredAmplitudes(DataSet& DS, DataPartitionVector& DP)
 
         // create thread for calculation on each partition
         for (auto& P : DP)
-            partial_sums.push_back(std::async(std::launch::async, &Model::partialSumOfLogsOfSquaredAmplitudes, this, P.get(), DS));
+            partial_sums.push_back(std::async(std::launch::async, &Model::partialSumOfLogsOfSquaredAmplitudes, this, P.get(),
+                                                  std::cref(static_cast<const StatusManager&>(DS))));
 
         // wait for each partition to finish calculating
         for (auto& s : partial_sums)
@@ -129,6 +262,59 @@ double Model::sumOfLogsOfSquaredAmplitudes(DataSet& DS, DataPartitionVector& DP)
     return log_L;
 }
 
+//-------------------------
+double Model::sumOfLogsOfSquaredAmplitudes(DataSet& DS, ThreadPool& pool) const
+{
+    for (const auto& P : pool.partitions())
+        if (P->begin() != P->end() and (*P->begin()).dataSet() != &DS)
+            throw exceptions::Exception("ThreadPool's partitions do not belong to DataSet", "Model::sumOfLogsOfSquaredAmplitudes");
+
+    if (auto CA = componentAmplitudes(DS))
+        return CA->sumOfLogsOfSquaredAmplitudes();
+
+    // update global calculation statuses (managed by data set)
+    DS.updateCalculationStatuses(dependencyGraph());
+
+    std::vector<double> partial_sums(pool.size(), 0);
+
+    pool.run([&](DataPartitionBase & D, unsigned i) {partial_sums[i] = partialSumOfLogsOfSquaredAmplitudes(&D, DS);});
+
+    double log_L = 0;
+    for (auto s : partial_sums)
+        log_L += s;
+
+    // Set all variable statuses to Unchanged
+    DS.setAll(kUnchanged);
+
+    return log_L;
+}
+
+//-------------------------
+double Model::sumOfLogsOfSquaredAmplitudes(DataSet& DS, WorkStealingScheduler& scheduler) const
+{
+    if (auto CA = componentAmplitudes(DS))
+        return CA->sumOfLogsOfSquaredAmplitudes();
+
+    // update global calculation statuses (managed by data set)
+    DS.updateCalculationStatuses(dependencyGraph());
+
+    // sums by worker
+    std::vector<double> partial_sums(scheduler.size(), 0);
+
+    // statuses of a worker are finished once, after its last chunk
+    scheduler.run(DS, [&](DataPartitionBase & D, unsigned i) {partial_sums[i] += logsOfSquaredAmplitudes(D, DS);},
+                  [](DataPartitionBase & D, unsigned) {finishPartition(D);});
+
+    double log_L = 0;
+    for (auto s : partial_sums)
+        log_L += s;
+
+    // Set all variable statuses to Unchanged
+    DS.setAll(kUnchanged);
+
+    return log_L;
+}
+
 //-------------------------
 bool Model::consistent() const
 {
@@ -245,6 +431,24 @@ void Model::setCoordinateSystem(const CoordinateSystem<double, 3>& cs)
     CoordinateSystem_ = unit(cs);
 }
 
+//-------------------------
+void Model::assertNoDataSets(const std::string& func) const
+{
+    if (*NDataSets_ > 0)
+        throw exceptions::Exception("data layout can't be changed while " + std::to_string(*NDataSets_)
+                                    + " data sets of the model exist", func);
+}
+
+//-------------------------
+void Model::setStoragePrecision(StoragePrecision p)
+{
+    assertNoDataSets("Model::setStoragePrecision");
+
+    for (auto& da : DataAccessors_)
+        if (auto sda = dynamic_cast<StaticDataAccessor*>(da))
+            sda->setPrecision(p);
+}
+
 //-------------------------
 std::array<double, 2> Model::massRange(const std::shared_ptr<ParticleCombination>& pc) const
 {
@@ -273,6 +477,28 @@ ComplexParameterVector Model::freeAmplitudes() const
     return InitialStateParticle_->freeAmplitudes();
 }
 
+//-------------------------
+bool Model::linearInFreeAmplitudes() const
+{
+    if (!InitialStateParticle_)
+        throw exceptions::Exception("Initial state unset", "Model::linearInFreeAmplitudes");
+
+    // collect free amplitudes of initial-state particle's channels
+    ParameterSet isp_free;
+    for (auto& c : InitialStateParticle_->channels())
+        for (auto& a : c->freeAmplitudes())
+            isp_free.insert(a);
+
+    // all other parameters must be fixed
+    for (const auto& da : DataAccessors_)
+        for (const auto& cdv : da->cachedDataValues())
+            for (const auto& p : cdv->parameterDependencies())
+                if (p->variableStatus() != kFixed and isp_free.find(p) == isp_free.end())
+                    return false;
+
+    return true;
+}
+
 //-------------------------
 void Model::addDataAccessor(DataAccessorSet::value_type da)
 {
@@ -332,6 +558,85 @@ void Model::prepareDataAccessors()
 
     }
 
+    std::vector<DataAccessor*> ordered(DataAccessors_.size(), nullptr);
+    for (auto& da : DataAccessors_)
+        ordered[da->index()] = da;
+
+    // number ParticleCombination's densely for symmetrization-index lookups
+    unsigned n_pc = ParticleCombinationCache_.setIds();
+    for (auto& da : DataAccessors_)
+        da->buildSymmetrizationIndexTable(n_pc);
+
+    const auto parameters = DependencyGraph_.parameters();
+    DependencyGraph_ = DependencyGraph(DataAccessors_, ParameterChangeLog_);
+
+    // parameters new to the graph were not logged when changed,
+    // so readers of the log must check all parameters once
+    if (DependencyGraph_.parameters() != parameters)
+        ParameterChangeLog_->clear();
+
+    // order static data accessors level by level: an accessor's level is
+    // one more than the highest level of the static accessors it depends on
+    std::map<const DataAccessor*, unsigned> level;
+    for (auto& da : ordered)
+        if (dynamic_cast<StaticDataAccessor*>(da))
+            level[da] = 0;
+
+    auto raise_level = [&](const DataAccessor* da, const std::shared_ptr<CachedDataValue>& dep) {
+        auto it = level.find(dep->owner());
+        if (it != level.end() and it->first != da and level[da] < it->second + 1) {
+            level[da] = it->second + 1;
+            return true;
+        }
+        return false;
+    };
+
+    // relax until no level changes; the number of passes is bounded by the number of levels
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (auto& da_l : level)
+            for (const auto& cdv : da_l.first->cachedDataValues()) {
+                for (const auto& dep : cdv->cachedDataValueDependencies())
+                    changed |= raise_level(da_l.first, dep);
+                for (const auto& dep : cdv->daughterCachedDataValueDependencies())
+                    changed |= raise_level(da_l.first, dep.CDV);
+            }
+    }
+
+    StaticDataAccessors_.clear();
+    for (auto& da : ordered)
+        if (level.count(da))
+            StaticDataAccessors_.push_back(static_cast<StaticDataAccessor*>(da));
+    std::stable_sort(StaticDataAccessors_.begin(), StaticDataAccessors_.end(),
+    [&](const StaticDataAccessor * A, const StaticDataAccessor * B) {return level[A] < level[B];});
+
+    // order decaying particles for block evaluation, daughters first
+    DecayingParticles_.clear();
+    std::function<void(const DecayingParticle*)> add_decaying_particle = [&](const DecayingParticle * dp) {
+        if (std::find(DecayingParticles_.begin(), DecayingParticles_.end(), dp) != DecayingParticles_.end())
+            return;
+        for (const auto& c : dp->channels())
+            for (const auto& d : c->daughters())
+                if (auto ddp = std::dynamic_pointer_cast<DecayingParticle>(d))
+                    add_decaying_particle(ddp.get());
+        DecayingParticles_.push_back(dp);
+    };
+    if (InitialStateParticle_)
+        add_decaying_particle(InitialStateParticle_.get());
+
+    // existing data sets must keep the layout they were created with
+    const auto offsets = DataOffsets_;
+    const auto offset_indices = DataOffsetIndices_;
+    const auto sizes = std::make_tuple(DataPointSize_, StaticDataSize_, SinglePrecisionOffset_, RecomputedDataSize_);
+
+    resolveStoragePolicies();
+
+    buildDataOffsets();
+
+    if (*NDataSets_ > 0 and (offsets != DataOffsets_ or offset_indices != DataOffsetIndices_
+                            or sizes != std::make_tuple(DataPointSize_, StaticDataSize_, SinglePrecisionOffset_, RecomputedDataSize_)))
+        throw exceptions::Exception("data layout changed while data sets of the model exist", "Model::prepareDataAccessors");
+
 #ifndef ELPP_DISABLE_DEBUG_LOGS
     for (auto& D : DataAccessors_) {
         std::cout << std::endl;
@@ -341,6 +646,188 @@ void Model::prepareDataAccessors()
 
 }
 
+//-------------------------
+void Model::applyStoragePolicies()
+{
+    // set recomputed from resolved policies; stored values are calculated
+    // when data points are added, without recomputing: also store all
+    // values that stored values depend on
+    for (auto& sda : StaticDataAccessors_)
+        sda->setRecomputed(sda->resolvedStoragePolicy() == kRecompute);
+
+    auto store = [](DataAccessor * da) {
+        if (!da->recomputed())
+            return false;
+        da->setRecomputed(false);
+        return true;
+    };
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (auto& sda : StaticDataAccessors_)
+            if (!sda->recomputed())
+                for (const auto& cdv : sda->cachedDataValues()) {
+                    for (const auto& dep : cdv->cachedDataValueDependencies())
+                        changed |= store(dep->owner());
+                    for (const auto& dep : cdv->daughterCachedDataValueDependencies())
+                        changed |= store(dep.CDV->owner());
+                }
+    }
+}
+
+//-------------------------
+void Model::resolveStoragePolicies()
+{
+    // kAuto is resolved once, and kept until the policy is set again;
+    // it is stored unless tuned or adopted from a file
+    for (auto& sda : StaticDataAccessors_)
+        if (sda->resolvedStoragePolicy() == kAuto)
+            sda->ResolvedStoragePolicy_ = kStore;
+
+    applyStoragePolicies();
+}
+
+//-------------------------
+void Model::tuneStoragePolicy()
+{
+    // resolving lays out data points differently for each trial
+    assertNoDataSets("Model::tuneStoragePolicy");
+
+    prepareDataAccessors();
+
+    std::vector<StaticDataAccessor*> tuned;
+    for (auto& sda : StaticDataAccessors_)
+        if (sda->storagePolicy() == kAuto) {
+            tuned.push_back(sda);
+            sda->ResolvedStoragePolicy_ = kStore;
+        }
+
+    if (tuned.empty())
+        return;
+
+    // time to calculate all amplitudes over a sample of data points,
+    // the shortest of a few repetitions
+    std::vector<FourVector<double> > P;
+    auto amplitude_time = [&]() {
+        applyStoragePolicies();
+        buildDataOffsets();
+
+        if (P.empty()) {
+            // arbitrary, non-collinear final-state momenta
+            for (size_t k = 0; k < 1024; ++k)
+                for (size_t i = 0; i < FinalStateParticles_.size(); ++i) {
+                    const double phi = i + 1. + 1e-3 * k;
+                    const ThreeVector<double> p({0.3 * cos(phi), 0.3 * sin(phi), 0.1 * i});
+                    P.push_back(FourVector<double>(sqrt(pow(FinalStateParticles_[i]->mass()->value(), 2) + norm(p)), p));
+                }
+        }
+        DataSet D(*this);
+        D.addPoints(P);
+
+        // with all statuses uncalculated, as after changing all parameters
+        const StatusManager uncalculated(DataAccessors_);
+        std::vector<std::complex<double> > A;
+        double t_min = std::numeric_limits<double>::max();
+        for (unsigned r = 0; r < 3; ++r) {
+            const auto start = std::chrono::steady_clock::now();
+            amplitudes(D, uncalculated, A);
+            const std::chrono::duration<double> t = std::chrono::steady_clock::now() - start;
+            t_min = std::min(t_min, t.count());
+        }
+        return t_min;
+    };
+
+    const double t_store = amplitude_time();
+
+    for (auto sda : tuned) {
+        sda->ResolvedStoragePolicy_ = kRecompute;
+        applyStoragePolicies();
+        // accessors that stored ones depend on are stored anyway
+        const double t_recompute = sda->recomputed() ? amplitude_time() : t_store;
+        sda->ResolvedStoragePolicy_ = t_recompute < t_store ? kRecompute : kStore;
+
+        LOG(INFO) << sda->data_accessor_type() << ": " << t_store << " s to calculate amplitudes with values stored, "
+                  << t_recompute << " s with values recomputed; "
+                  << (sda->ResolvedStoragePolicy_ == kRecompute ? "recomputing" : "storing");
+    }
+
+    applyStoragePolicies();
+    buildDataOffsets();
+}
+
+//-------------------------
+void Model::adoptStoragePolicies(const std::string& filename)
+{
+    prepareDataAccessors();
+
+    const MappedFile F(filename);
+    const auto recomputed = readRecomputedDataAccessors(F.data(), F.size(), filename);
+    // a file of another model is reported when its data are read
+    if (recomputed.size() != DataAccessors_.size())
+        return;
+
+    bool changed = false;
+    for (auto& sda : StaticDataAccessors_)
+        if (sda->storagePolicy() == kAuto and sda->recomputed() != recomputed[sda->index()]) {
+            sda->ResolvedStoragePolicy_ = recomputed[sda->index()] ? kRecompute : kStore;
+            changed = true;
+        }
+
+    if (!changed)
+        return;
+
+    assertNoDataSets("Model::adoptStoragePolicies");
+
+    applyStoragePolicies();
+    buildDataOffsets();
+}
+
+//-------------------------
+void Model::buildDataOffsets()
+{
+    // build offsets of each (DataAccessor, symmetrization) row inside
+    // a DataPoint's storage: rows are laid out in order of DataAccessor
+    // index, then symmetrization index. Static rows come first, with
+    // double-precision rows followed by single-precision rows packed two
+    // floats to a double, whose offsets count floats; parameter-dependent
+    // rows follow, with offsets counted from their beginning. Recomputed
+    // rows are laid out in the storage of recomputed values.
+    std::vector<DataAccessor*> ordered(DataAccessors_.size(), nullptr);
+    for (auto& da : DataAccessors_)
+        ordered[da->index()] = da;
+
+    std::vector<std::vector<unsigned> > offsets(ordered.size());
+
+    // lay out rows of selected data accessors beginning at offset; returns end of rows
+    auto lay_out = [&](unsigned offset, bool is_static, bool recomputed, StoragePrecision p) {
+        for (size_t i = 0; i < ordered.size(); ++i) {
+            if (ordered[i]->isStatic() != is_static or ordered[i]->recomputed() != recomputed
+                    or (is_static and !recomputed and ordered[i]->precision() != p))
+                continue;
+            offsets[i].resize(ordered[i]->maxSymmetrizationIndex() + 1);
+            for (auto& o : offsets[i]) {
+                o = offset;
+                offset += ordered[i]->size();
+            }
+        }
+        return offset;
+    };
+
+    SinglePrecisionOffset_ = lay_out(0, true, false, kDoublePrecision);
+    StaticDataSize_ = (lay_out(2 * SinglePrecisionOffset_, true, false, kSinglePrecision) + 1) / 2;
+    DataPointSize_ = StaticDataSize_ + lay_out(0, false, false, kDoublePrecision);
+    RecomputedDataSize_ = lay_out(0, true, true, kDoublePrecision);
+
+    // flatten table, and hand each data accessor its rows
+    DataOffsets_.clear();
+    DataOffsetIndices_.clear();
+    for (size_t i = 0; i < ordered.size(); ++i) {
+        DataOffsetIndices_.push_back(DataOffsets_.size());
+        DataOffsets_.insert(DataOffsets_.end(), offsets[i].begin(), offsets[i].end());
+        ordered[i]->setDataOffsets(offsets[i]);
+    }
+    DataOffsetIndices_.push_back(DataOffsets_.size());
+}
+
 //-------------------------
 const MassAxes Model::massAxes(std::vector<std::vector<unsigned> > pcs)
 {
@@ -531,19 +1018,80 @@ std::vector<FourVector<double> > Model::calculateFourMomenta(const MassAxes& axe
 }
 
 //-------------------------
-DataSet Model::dataSet(size_t n)
+DataSet Model::dataSet(size_t n, DataLayout layout)
 {
     // prepare DataAccessors
     prepareDataAccessors();
 
     // create empty data set
-    DataSet D(*this);
+    DataSet D(*this, layout);
 
     D.addEmptyPoints(n);
 
     return D;
 }
 
+//-------------------------
+DataSet Model::dataSet(const std::string& filename)
+{
+    adoptStoragePolicies(filename);
+
+    return DataSet(*this, filename);
+}
+
+//-------------------------
+void Model::setStoragePolicy(StoragePolicy p)
+{
+    assertNoDataSets("Model::setStoragePolicy");
+
+    for (auto& da : DataAccessors_)
+        if (auto sda = dynamic_cast<StaticDataAccessor*>(da))
+            if (sda != FourMomenta_.get())
+                sda->setStoragePolicy(p);
+}
+
+//-------------------------
+double Model::storagePrecisionDifference(const std::vector<FourVector<double> >& P)
+{
+    assertNoDataSets("Model::storagePrecisionDifference");
+
+    // store precisions set
+    std::map<StaticDataAccessor*, StoragePrecision> precisions;
+    for (auto& da : DataAccessors_)
+        if (auto sda = dynamic_cast<StaticDataAccessor*>(da))
+            precisions[sda] = sda->precision();
+
+    auto sum_of_logs = [&]() {
+        auto D = dataSet();
+        D.addPoints(P);
+        return sumOfLogsOfSquaredAmplitudes(D);
+    };
+
+    // restore precisions, and the layout following from them
+    auto restore = [&]() {
+        for (auto& kv : precisions)
+            kv.first->setPrecision(kv.second);
+        prepareDataAccessors();
+    };
+
+    const double L = sum_of_logs();
+
+    setStoragePrecision(kDoublePrecision);
+    double L_double;
+    try {
+        L_double = sum_of_logs();
+    } catch (...) {
+        restore();
+        throw;
+    }
+    restore();
+
+    LOG(INFO) << "Sum of logs of squared amplitudes over " << P.size() / FinalStateParticles_.size() << " data points: "
+              << L << " with precisions set, " << L_double << " in double precision";
+
+    return L - L_double;
+}
+
 //-------------------------
 void Model::printDataAccessors(bool printParticleCombinations)
 {
@@ -0,0 +1,189 @@
+#include "NormalizationIntegral.h"
+
+#include "CachedDataValue.h"
+#include "Constants.h"
+#include "DataAccessor.h"
+#include "DataSet.h"
+#include "DecayChannel.h"
+#include "DecayingParticle.h"
+#include "Exceptions.h"
+#include "MassShape.h"
+#include "Model.h"
+#include "Resonance.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace yap {
+
+//-------------------------
+NormalizationIntegral::NormalizationIntegral(const Model& m) :
+    Model_(&m),
+    Terms_(amplitudeTerms(m)),
+    Interference_(Terms_.size() * Terms_.size(), Complex_0),
+    Statuses_(m.dataAccessors()),
+    DataSetGeneration_(0),
+    NDataPoints_(0)
+{
+}
+
+//-------------------------
+std::vector<size_t> NormalizationIntegral::changedTerms(DataSet& DS)
+{
+    if (DS.model() != Model_)
+        throw exceptions::Exception("DataSet does not belong to Model", "NormalizationIntegral::update");
+
+    // update global calculation statuses (managed by data set)
+    DS.updateCalculationStatuses(Model_->dependencyGraph());
+
+    // update statuses of values interference matrix was calculated with
+    Statuses_.updateCalculationStatuses(Model_->dependencyGraph());
+
+    std::vector<size_t> rows;
+    for (size_t j = 0; j < Terms_.size(); ++j) {
+        const auto& t = Terms_[j];
+        // all rows are recalculated for a new data set
+        bool changed = DS.generation() != DataSetGeneration_;
+        for (size_t i = 0; i < t.SymmetrizationIndices.size() and !changed; ++i)
+            changed = Statuses_.status(*t.Fixed, t.SymmetrizationIndices[i]) == kUncalculated
+                      or (t.MassShape and Statuses_.status(*t.MassShape, t.MassShapeSymmetrizationIndices[i]) == kUncalculated);
+        if (changed)
+            rows.push_back(j);
+    }
+    return rows;
+}
+
+//-------------------------
+void NormalizationIntegral::finishUpdate(DataSet& DS)
+{
+    // all rows are now calculated with the current values
+    for (const auto& da : Model_->dataAccessors())
+        Statuses_.set(*da, kCalculated);
+
+    DataSetGeneration_ = DS.generation();
+    NDataPoints_ = DS.points().size();
+
+    // Set all variable statuses to Unchanged
+    DS.setAll(kUnchanged);
+}
+
+//-------------------------
+std::vector<std::complex<double> > NormalizationIntegral::partialRows(DataPartitionBase* D, const StatusManager& global, const std::vector<size_t>& rows) const
+{
+    const size_t K = Terms_.size();
+
+    std::vector<std::complex<double> > R(rows.size() * K, Complex_0);
+    std::vector<std::complex<double> > F(K);
+
+    // only the channels of changed terms are evaluated;
+    // the fixed amplitudes of all other terms are already stored in the data points
+    std::vector<const DecayChannel*> channels;
+    bool mass_shape = false;
+    for (auto r : rows) {
+        if (std::find(channels.begin(), channels.end(), Terms_[r].Channel.get()) == channels.end())
+            channels.push_back(Terms_[r].Channel.get());
+        mass_shape |= (bool)Terms_[r].MassShape;
+    }
+
+    const auto isp = Model_->initialStateParticle();
+    const auto res = mass_shape ? std::dynamic_pointer_cast<const Resonance>(isp) : nullptr;
+
+    for (DataIterator d = D->restart(); d != D->end(); ++d) {
+        D->inheritCalculationStatuses(global);
+
+        {
+            // recompute static data that are not stored
+            RecomputedStaticData R(*d, *D);
+
+            for (const auto& kv : isp->symmetrizationIndices()) {
+                for (auto c : channels)
+                    if (c->hasParticleCombination(kv.first))
+                        c->amplitudes(*d, kv.first, *D);
+                if (res)
+                    res->massShape()->amplitude(*d, kv.first, *D);
+            }
+        }
+
+        for (size_t k = 0; k < K; ++k)
+            F[k] = Terms_[k].fixedAmplitude(*d);
+
+        for (size_t r = 0; r < rows.size(); ++r)
+            for (size_t k = 0; k < K; ++k)
+                R[r * K + k] += F[rows[r]] * conj(F[k]);
+    }
+
+    D->detachCalculationStatuses();
+
+    // set all variable statuses to Unchanged
+    D->setAll(kUnchanged);
+
+    return R;
+}
+
+//-------------------------
+void NormalizationIntegral::setRows(const std::vector<size_t>& rows, const std::vector<std::complex<double> >& R)
+{
+    const size_t K = Terms_.size();
+    for (size_t r = 0; r < rows.size(); ++r)
+        for (size_t k = 0; k < K; ++k) {
+            Interference_[rows[r] * K + k] = R[r * K + k];
+            Interference_[k * K + rows[r]] = conj(R[r * K + k]);
+        }
+}
+
+//-------------------------
+void NormalizationIntegral::update(DataSet& DS, ThreadPool& pool)
+{
+    auto rows = changedTerms(DS);
+
+    if (!rows.empty()) {
+
+        // rows by partition
+        std::vector<std::vector<std::complex<double> > > partial_rows(pool.size());
+
+        pool.run([&](DataPartitionBase & D, unsigned i) {partial_rows[i] = partialRows(&D, DS, rows);});
+
+        std::vector<std::complex<double> > R(rows.size() * Terms_.size(), Complex_0);
+        for (const auto& r : partial_rows)
+            for (size_t i = 0; i < R.size(); ++i)
+                R[i] += r[i];
+
+        setRows(rows, R);
+    }
+
+    finishUpdate(DS);
+}
+
+//-------------------------
+void NormalizationIntegral::update(DataSet& DS)
+{
+    auto rows = changedTerms(DS);
+
+    if (!rows.empty())
+        setRows(rows, partialRows(&DS, StatusManager(DS), rows));
+
+    finishUpdate(DS);
+}
+
+//-------------------------
+double NormalizationIntegral::integral() const
+{
+    const size_t K = Terms_.size();
+
+    std::vector<std::complex<double> > c;
+    c.reserve(K);
+    for (const auto& t : Terms_)
+        c.push_back(t.Free->value());
+
+    // sum_jk c_j M_jk c_k^*; M is hermitian, so the sum is real
+    double I = 0;
+    for (size_t j = 0; j < K; ++j) {
+        I += real(c[j] * Interference_[j * K + j] * conj(c[j]));
+        for (size_t k = j + 1; k < K; ++k)
+            I += 2 * real(c[j] * Interference_[j * K + k] * conj(c[k]));
+    }
+
+    return I;
+}
+
+}
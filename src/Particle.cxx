@@ -1,6 +1,7 @@
 #include "Particle.h"
 
 #include "logging.h"
+#include "spin.h"
 
 namespace yap {
 
@@ -15,6 +16,16 @@ Particle::Particle(const QuantumNumbers& q, double m, std::string name) :
     Name_(name)
 {}
 
+//-------------------------
+std::vector<std::complex<double> > Particle::amplitudes(DataPoint& d, const std::shared_ptr<ParticleCombination>& pc, StatusManager& sm) const
+{
+    const int twoJ = quantumNumbers().twoJ();
+    std::vector<std::complex<double> > A(twoJ + 1);
+    for (int two_m = -twoJ; two_m <= twoJ; two_m += 2)
+        A[spin_projection_index(two_m, twoJ)] = amplitude(d, pc, two_m, sm);
+    return A;
+}
+
 //-------------------------
 void Particle::setMass(std::shared_ptr<RealParameter> m)
 {
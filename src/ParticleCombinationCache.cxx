@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <iomanip>
 
 namespace yap {
@@ -66,6 +67,33 @@ void ParticleCombinationCache::addToCache(shared_ptr_type pc)
     // setLineage(pc);
 }
 
+//-------------------------
+unsigned ParticleCombinationCache::setIds()
+{
+    // unset all IDs first, so each is assigned once below
+    std::function<void(ParticleCombination&, int)> set = [&](ParticleCombination & pc, int id) {
+        pc.Id_ = id;
+        for (auto& d : pc.Daughters_)
+            set(*d, id);
+    };
+    for (auto& w : *this)
+        if (!w.expired())
+            set(*w.lock(), -1);
+
+    unsigned n = 0;
+    std::function<void(ParticleCombination&)> assign = [&](ParticleCombination & pc) {
+        if (pc.Id_ < 0)
+            pc.Id_ = n++;
+        for (auto& d : pc.Daughters_)
+            assign(*d);
+    };
+    for (auto& w : *this)
+        if (!w.expired())
+            assign(*w.lock());
+
+    return n;
+}
+
 //-------------------------
 bool ParticleCombinationCache::consistent() const
 {
@@ -57,8 +57,7 @@ std::complex<double> PoleMass::amplitude(DataPoint& d, const std::shared_ptr<Par
     // recalculate, cache, & return, if necessary
     if (sm.status(*T(), symIndex) == kUncalculated) {
 
-        // T = 1 / (M^2 - m^2)
-        std::complex<double> t = 1. / (pow(Mass_->value(), 2) - model()->fourMomenta()->m2(d, pc));
+        std::complex<double> t = calc(d, pc);
 
         T()->setValue(t, d, symIndex, sm);
 
@@ -72,6 +71,13 @@ std::complex<double> PoleMass::amplitude(DataPoint& d, const std::shared_ptr<Par
     return T()->value(d, symIndex);
 }
 
+//-------------------------
+std::complex<double> PoleMass::calc(const DataPoint& d, const std::shared_ptr<ParticleCombination>& pc) const
+{
+    // T = 1 / (M^2 - m^2)
+    return 1. / (pow(Mass_->value(), 2) - model()->fourMomenta()->m2(d, pc));
+}
+
 //-------------------------
 bool PoleMass::consistent() const
 {
@@ -24,6 +24,23 @@ std::complex<double> Resonance::amplitude(DataPoint& d, const std::shared_ptr<Pa
     return DecayingParticle::amplitude(d, pc, two_m, sm) * MassShape_->amplitude(d, pc, sm);
 }
 
+//-------------------------
+std::vector<std::complex<double> > Resonance::amplitudes(DataPoint& d, const std::shared_ptr<ParticleCombination>& pc, StatusManager& sm) const
+{
+    auto A = DecayingParticle::amplitudes(d, pc, sm);
+    const auto ms = MassShape_->amplitude(d, pc, sm);
+    for (auto& a : A)
+        a *= ms;
+    return A;
+}
+
+//-------------------------
+void Resonance::calculate(const DataPointBlock& B, StatusManager& sm) const
+{
+    MassShape_->calculate(B, sm);
+    DecayingParticle::calculate(B, sm);
+}
+
 //-------------------------
 bool Resonance::consistent() const
 {
@@ -41,6 +58,15 @@ bool Resonance::consistent() const
     return C;
 }
 
+//-------------------------
+CachedDataValueSet Resonance::cachedDataValuesItDependsOn()
+{
+    auto S = DecayingParticle::cachedDataValuesItDependsOn();
+    auto M = MassShape_->cachedDataValuesItDependsOn();
+    S.insert(M.begin(), M.end());
+    return S;
+}
+
 //-------------------------
 void Resonance::addToModel()
 {
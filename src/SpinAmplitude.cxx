@@ -12,7 +12,8 @@ SpinAmplitude::SpinAmplitude(unsigned two_J, unsigned two_j1, unsigned two_j2, u
     InitialTwoJ_(two_J),
     FinalTwoJ_( {two_j1, two_j2}),
             L_(l),
-            TwoS_(two_s)
+            TwoS_(two_s),
+            AmplitudeVectors_(two_J + 1)
 {
     // check JLS triangle
     if (!triangle(InitialTwoJ_, 2 * L_, TwoS_))
@@ -48,23 +49,21 @@ void SpinAmplitude::calculate(DataPoint& d, StatusManager& sm) const
 
         unsigned symIndex = symmetrizationIndex(pc);
 
-        // loop over mapping of parent spin projection to AmplitudeSubmap
-        for (auto& aM_kv : Amplitudes_) {
+        // loop over parent spin projections
+        for (int two_M = -(int)InitialTwoJ_; two_M <= (int)InitialTwoJ_; two_M += 2) {
 
-            const auto& two_M = aM_kv.first; // parent spin projection
-
-            // loop over mappin of daughter spin projection pairs to amplitudes
-            for (auto& aSM_kv : aM_kv.second)
+            // loop over daughter spin projection pairs and amplitudes
+            for (auto& spp_a : amplitudes(two_M))
 
                 // if yet uncalculated
-                if (sm.status(*aSM_kv.second, symIndex) == kUncalculated) {
+                if (sm.status(*spp_a.second, symIndex) == kUncalculated) {
 
-                    const auto& spp = aSM_kv.first; // SpinProjectionPair of daughters
+                    const auto& spp = spp_a.first; // SpinProjectionPair of daughters
 
                     auto val = calc(two_M, spp[0], spp[1], d, pc);
                     FDEBUG(*this << " := " << val << ", for " << *pc << " for " << two_M << " -> " << spp[0] << " + " << spp[1]);
 
-                    aSM_kv.second->setValue(val, d, symIndex, sm);
+                    spp_a.second->setValue(val, d, symIndex, sm);
 
                 }
         }
@@ -96,6 +95,9 @@ std::set<int> SpinAmplitude::twoM() const
 //-------------------------
 void SpinAmplitude::addAmplitude(int two_M, int two_m1, int two_m2)
 {
+    if (std::abs(two_M) > (int)InitialTwoJ_ or !is_even(InitialTwoJ_ + two_M))
+        throw exceptions::Exception("invalid spin projection " + spin_to_string(two_M), "SpinAmplitude::addAmplitude");
+
     // retrieve (or create) AmplitudeSubmap for two_M
     auto& ASM = Amplitudes_[two_M];
 
@@ -109,6 +111,7 @@ void SpinAmplitude::addAmplitude(int two_M, int two_m1, int two_m2)
     FDEBUG("adding CachedDataValue for " << spin_to_string(two_M) << " -> " << m1m2[0] << " + " << m1m2[1]
            << " in " << *this)
     ASM[m1m2] = ComplexCachedDataValue::create(this);
+    AmplitudeVectors_[spin_projection_index(two_M, InitialTwoJ_)].emplace_back(m1m2, ASM[m1m2].get());
 }
 
 //-------------------------
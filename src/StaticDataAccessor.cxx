@@ -0,0 +1,24 @@
+#include "StaticDataAccessor.h"
+
+#include "Model.h"
+
+namespace yap {
+
+//-------------------------
+void StaticDataAccessor::setPrecision(StoragePrecision p)
+{
+    if (model())
+        model()->assertNoDataSets("StaticDataAccessor::setPrecision");
+    DataAccessor::setPrecision(p);
+}
+
+//-------------------------
+void StaticDataAccessor::setStoragePolicy(StoragePolicy p)
+{
+    if (model())
+        model()->assertNoDataSets("StaticDataAccessor::setStoragePolicy");
+    StoragePolicy_ = p;
+    ResolvedStoragePolicy_ = p;
+}
+
+}
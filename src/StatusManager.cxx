@@ -2,13 +2,19 @@
 
 #include "CachedDataValue.h"
 #include "DataAccessor.h"
+#include "DependencyGraph.h"
+#include "Parameter.h"
 #include "VariableStatus.h"
 
 namespace yap {
 
 //-------------------------
 StatusManager::StatusManager(const DataAccessorSet& sDA)
-    : Statuses_(sDA.size())
+    : Statuses_(sDA.size()),
+      Inherited_(nullptr),
+      Epoch_(0),
+      ChangeLog_(nullptr),
+      ChangeLogPosition_(0)
 {
     for (const auto& da : sDA) {
         Statuses_[da->index()].resize(da->cachedDataValues().size());
@@ -17,6 +23,30 @@ StatusManager::StatusManager(const DataAccessorSet& sDA)
     }
 }
 
+//-------------------------
+StatusManager::StatusManager(const StatusManager& other)
+    : Statuses_(other.Statuses_),
+      Inherited_(nullptr),
+      Epoch_(0),
+      ChangeLog_(other.ChangeLog_),
+      ChangeLogPosition_(other.ChangeLogPosition_)
+{
+    if (other.Inherited_)
+        copyCalculationStatuses(other);
+}
+
+//-------------------------
+StatusManager& StatusManager::operator=(const StatusManager& other)
+{
+    Statuses_ = other.Statuses_;
+    Inherited_ = nullptr;
+    ChangeLog_ = other.ChangeLog_;
+    ChangeLogPosition_ = other.ChangeLogPosition_;
+    if (other.Inherited_)
+        copyCalculationStatuses(other);
+    return *this;
+}
+
 //-------------------------
 CachedDataValue::Status& StatusManager::status(const CachedDataValue& cdv, size_t sym_index)
 {
@@ -33,16 +63,20 @@ CachedDataValue::Status& StatusManager::status(const CachedDataValue& cdv, size_
 //-------------------------
 void StatusManager::set(const CachedDataValue& cdv, const CalculationStatus& stat)
 {
-    for (auto& s : Statuses_[cdv.owner()->index()][cdv.index()])
+    for (auto& s : Statuses_[cdv.owner()->index()][cdv.index()]) {
         s.Calculation = stat;
+        s.Epoch = Epoch_;
+    }
 }
 
 //-------------------------
 void StatusManager::set(const DataAccessor& da, const CalculationStatus& stat)
 {
     for (auto& v : Statuses_[da.index()])
-        for (auto& s : v)
+        for (auto& s : v) {
             s.Calculation = stat;
+            s.Epoch = Epoch_;
+        }
 }
 
 //-------------------------
@@ -57,9 +91,49 @@ void StatusManager::copyCalculationStatuses(const StatusManager& sm)
             if (Statuses_[i][j].size() != sm.Statuses_[i][j].size())
                 throw exceptions::Exception("size mismatch", "StatusManager::setCalculationStatus");
             for (size_t k = 0; k < Statuses_[i][j].size(); ++k)
-                Statuses_[i][j][k].Calculation = sm.Statuses_[i][j][k].Calculation;
+                Statuses_[i][j][k].Calculation = sm.status(i, j, k).Calculation;
         }
     }
+    Inherited_ = nullptr;
+}
+
+//-------------------------
+void StatusManager::inheritCalculationStatuses(const StatusManager& sm)
+{
+    if (&sm == this)
+        throw exceptions::Exception("cannot inherit from self", "StatusManager::inheritCalculationStatuses");
+
+    // structure is checked only when inheriting from a new manager
+    if (&sm != Inherited_) {
+        detachCalculationStatuses();
+        copyCalculationStatuses(sm);
+    }
+
+    Inherited_ = &sm;
+
+    // a new epoch invalidates all statuses;
+    // on overflow, restamp all to avoid false matches
+    if (++Epoch_ == 0) {
+        for (auto& v1 : Statuses_)
+            for (auto& v2 : v1)
+                for (auto& s : v2)
+                    s.Epoch = 0;
+        Epoch_ = 1;
+    }
+}
+
+//-------------------------
+void StatusManager::detachCalculationStatuses()
+{
+    if (!Inherited_)
+        return;
+
+    for (size_t i = 0; i < Statuses_.size(); ++i)
+        for (size_t j = 0; j < Statuses_[i].size(); ++j)
+            for (size_t k = 0; k < Statuses_[i][j].size(); ++k)
+                status(i, j, k);
+
+    Inherited_ = nullptr;
 }
 
 //-------------------------
@@ -78,6 +152,14 @@ void StatusManager::updateCalculationStatus(const CachedDataValue& cdv, const st
     if (status(cdv, sym_index) == kUncalculated)
         return;
 
+    // check parameter dependencies, since cdv may be reached
+    // as a dependency before it is itself updated
+    for (const auto& p : cdv.parameterDependencies())
+        if (p->variableStatus() == kChanged) {
+            status(cdv, sym_index) = kUncalculated;
+            return;
+        }
+
     // check CachedDataValue dependencies
     for (const auto& c : cdv.cachedDataValueDependencies()) {
 
@@ -147,4 +229,57 @@ void StatusManager::updateCalculationStatuses(const DataAccessorSet& sDA)
             updateCalculationStatuses(*cdv);
 }
 
+//-------------------------
+void StatusManager::updateCalculationStatuses(const DependencyGraph& G)
+{
+    // flag CachedDataValue's with changed parameters
+    std::vector<bool> changed(G.nCachedDataValues(), false);
+    std::vector<bool> checked(G.parameters().size(), false);
+    auto check = [&](int p) {
+        if (p < 0 or checked[p])
+            return;
+        checked[p] = true;
+        if (G.parameters()[p]->variableStatus() == kChanged)
+            for (auto c = G.dependentsBegin(p); c != G.dependentsEnd(p); ++c)
+                changed[*c] = true;
+    };
+
+    // check only parameters changed since last update, if log still holds them;
+    // else check all
+    const auto log = G.changeLog().get();
+    if (log and log == ChangeLog_ and log->holds(ChangeLogPosition_))
+        for (auto p = log->begin(ChangeLogPosition_); p != log->end(); ++p)
+            check(G.parameterIndex(*p));
+    else
+        for (size_t p = 0; p < checked.size(); ++p)
+            check(p);
+
+    ChangeLog_ = log;
+    ChangeLogPosition_ = log ? log->position() : 0;
+
+    // nodes are sorted such that dependencies are always updated first
+    const auto& nodes = G.nodes();
+    for (size_t n = 0; n < nodes.size(); ++n) {
+
+        auto& S = status(nodes[n].DataAccessorIndex, nodes[n].CachedDataValueIndex, nodes[n].SymmetrizationIndex);
+
+        // if already marked uncalculated, continue
+        if (S == kUncalculated)
+            continue;
+
+        if (changed[nodes[n].ValueIndex]) {
+            S = kUncalculated;
+            continue;
+        }
+
+        for (auto d = G.dependenciesBegin(n); d != G.dependenciesEnd(n); ++d) {
+            const auto& s = status(nodes[*d].DataAccessorIndex, nodes[*d].CachedDataValueIndex, nodes[*d].SymmetrizationIndex);
+            if (s == kUncalculated or s == kChanged) {
+                S = kUncalculated;
+                break;
+            }
+        }
+    }
+}
+
 }
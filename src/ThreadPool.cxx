@@ -0,0 +1,132 @@
+#include "ThreadPool.h"
+
+#include "Exceptions.h"
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
+namespace yap {
+
+//-------------------------
+ThreadPool::ThreadPool(DataPartitionVector& DP, bool pin_threads) :
+    Partitions_(DP),
+    Task_(nullptr),
+    Generation_(0),
+    Remaining_(0),
+    Stop_(false),
+    Exceptions_(DP.size())
+{
+    if (Partitions_.empty())
+        throw exceptions::Exception("DataPartitionVector is empty", "ThreadPool::ThreadPool");
+
+    Threads_.reserve(Partitions_.size() - 1);
+    try {
+        for (unsigned i = 1; i < Partitions_.size(); ++i)
+            Threads_.emplace_back(&ThreadPool::work, this, i);
+    } catch (...) {
+        // the destructor is not called, so threads already started are joined here
+        stop();
+        throw;
+    }
+
+#ifdef __linux__
+    if (pin_threads) {
+        unsigned n_cores = std::max(std::thread::hardware_concurrency(), 1u);
+        // leave core 0 to the calling thread, as far as possible
+        for (unsigned i = 0; i < Threads_.size(); ++i) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET((i + 1) % n_cores, &cpus);
+            pthread_setaffinity_np(Threads_[i].native_handle(), sizeof(cpu_set_t), &cpus);
+        }
+    }
+#endif
+}
+
+//-------------------------
+ThreadPool::~ThreadPool()
+{
+    stop();
+}
+
+//-------------------------
+void ThreadPool::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(Mutex_);
+        Stop_ = true;
+    }
+    Start_.notify_all();
+
+    for (auto& t : Threads_)
+        t.join();
+}
+
+//-------------------------
+void ThreadPool::work(unsigned i)
+{
+    unsigned long generation = 0;
+
+    while (true) {
+
+        const Task* task = nullptr;
+
+        // wait for next generation
+        {
+            std::unique_lock<std::mutex> lock(Mutex_);
+            Start_.wait(lock, [&] {return Stop_ or Generation_ != generation;});
+            if (Stop_)
+                return;
+            generation = Generation_;
+            task = Task_;
+        }
+
+        try {
+            (*task)(*Partitions_[i], i);
+        } catch (...) {
+            Exceptions_[i] = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(Mutex_);
+            if (--Remaining_ == 0)
+                Done_.notify_one();
+        }
+    }
+}
+
+//-------------------------
+void ThreadPool::run(const Task& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(Mutex_);
+        Task_ = &task;
+        Remaining_ = Threads_.size();
+        std::fill(Exceptions_.begin(), Exceptions_.end(), nullptr);
+        ++Generation_;
+    }
+    Start_.notify_all();
+
+    // calculate first partition in this thread
+    try {
+        task(*Partitions_[0], 0);
+    } catch (...) {
+        Exceptions_[0] = std::current_exception();
+    }
+
+    // wait for workers to finish
+    {
+        std::unique_lock<std::mutex> lock(Mutex_);
+        Done_.wait(lock, [&] {return Remaining_ == 0;});
+        Task_ = nullptr;
+    }
+
+    for (auto& e : Exceptions_)
+        if (e)
+            std::rethrow_exception(e);
+}
+
+}
@@ -5,7 +5,11 @@
 #include "MathUtilities.h"
 #include "spin.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace yap {
@@ -19,9 +23,45 @@ using KappaFactorVector = std::vector<double>;
 // second index is for J + N, in [0, min(J + M, floor(J))]
 using dMatrix = std::vector<std::vector<KappaFactorVector> >;
 
-// Cache of d-matrix kappa term factors
-// index is for (2J - 1), since J = 0 requires no cache
-static std::vector<dMatrix> CachedMatrices_;
+/// \struct Cache
+/// \brief Tables for all spins up to MaxTwoJ. A published cache is
+/// never modified; caching a higher spin publishes a new one.
+struct Cache {
+    /// twice the highest spin cached
+    unsigned MaxTwoJ = 0;
+
+    /// d-matrix kappa term factors,
+    /// index is for (2J - 1), since J = 0 requires no cache
+    std::vector<dMatrix> Matrices;
+
+    /// factors sqrt(k / 2J) for k in [0, 2J] for the recurrence in J,
+    /// index is for (2J - 1)
+    std::vector<std::vector<double> > RecurrenceFactors;
+};
+
+// currently published cache, read without locking
+static std::atomic<const Cache*> Cache_(nullptr);
+
+// guards the creation of caches
+static std::mutex CacheMutex_;
+
+// owns all created caches; superseded caches are kept,
+// since other threads may still be reading from them
+static std::vector<std::unique_ptr<const Cache> > Caches_;
+
+// \return kappa term factors for spin J
+static dMatrix kappaFactors(unsigned twoJ);
+
+// \return cache holding spin J, caching it if necessary
+static const Cache& cached(unsigned twoJ)
+{
+    const Cache* C = Cache_.load(std::memory_order_acquire);
+    if (C and C->MaxTwoJ >= twoJ)
+        return *C;
+
+    cache(twoJ);
+    return *Cache_.load(std::memory_order_acquire);
+}
 
 }
 
@@ -58,13 +98,13 @@ double dFunction(unsigned twoJ, int twoM, int twoN, double beta)
         return 1;
 
     // cache dMatrix for J if necessary
-    dMatrix::cache(twoJ);
+    const auto& C = dMatrix::cached(twoJ);
     // if problem with caching (should not happen!)
-    if (twoJ > dMatrix::CachedMatrices_.size())
+    if (twoJ > C.Matrices.size())
         throw exceptions::Exception(std::string("could not cache Wigner d function for J = ") + spin_to_string(twoJ),
                                     "WignerD::dFunction");
 
-    const dMatrix::KappaFactorVector& KF = dMatrix::CachedMatrices_[twoJ - 1][(twoJ + twoM) / 2][(twoJ + twoN) / 2];
+    const dMatrix::KappaFactorVector& KF = C.Matrices[twoJ - 1][(twoJ + twoM) / 2][(twoJ + twoN) / 2];
 
     unsigned MminusN = (twoM - twoN) / 2;
 
@@ -78,17 +118,79 @@ double dFunction(unsigned twoJ, int twoM, int twoN, double beta)
     return dMatrixElement;
 }
 
+//-------------------------
+void dMatrix::calculate(unsigned twoJ, double cosBeta, std::vector<double>& d)
+{
+    // d^0 = 1
+    d.assign(1, 1.);
+    if (twoJ == 0)
+        return;
+
+    const auto& C = cached(twoJ);
+
+    // d^(1/2) = ((cos(beta/2), -sin(beta/2)), (sin(beta/2), cos(beta/2))), with beta in [0, pi]
+    const double c = std::sqrt(std::max(0., (1 + cosBeta) / 2));
+    const double s = std::sqrt(std::max(0., (1 - cosBeta) / 2));
+
+    // d^j_(m'm) = sum_(a,b = +-1/2) (j - 1/2, m' - a; 1/2, a | j, m') (j - 1/2, m - b; 1/2, b | j, m) d^(j-1/2)_(m'-a, m-b) d^(1/2)_(ab),
+    // with (j - 1/2, m - b; 1/2, b | j, m) = sqrt((j + 2bm) / 2j);
+    // all terms are bounded by one, making the recurrence stable
+    std::vector<double> prev;
+    for (unsigned n = 1; n <= twoJ; ++n) {
+        // n = 2j; prev holds d^(j-1/2) as n x n matrix
+        prev.swap(d);
+        d.assign((n + 1) * (n + 1), 0.);
+
+        const auto& f = C.RecurrenceFactors[n - 1];
+
+        for (unsigned i = 0; i <= n; ++i) {
+            for (unsigned k = 0; k <= n; ++k) {
+                double v = 0;
+                if (i > 0 and k > 0)
+                    v += f[i] * f[k] * c * prev[(i - 1) * n + k - 1];
+                if (i > 0 and k < n)
+                    v -= f[i] * f[n - k] * s * prev[(i - 1) * n + k];
+                if (i < n and k > 0)
+                    v += f[n - i] * f[k] * s * prev[i * n + k - 1];
+                if (i < n and k < n)
+                    v += f[n - i] * f[n - k] * c * prev[i * n + k];
+                d[i * (n + 1) + k] = v;
+            }
+        }
+    }
+}
+
 //-------------------------
 void dMatrix::cache(unsigned twoJ)
 {
+    std::lock_guard<std::mutex> lock(CacheMutex_);
+
+    const Cache* C = Cache_.load(std::memory_order_acquire);
+
     /// d-matrix has already been cached for this spin
-    if (twoJ == 0 or (twoJ <= CachedMatrices_.size() and !CachedMatrices_[twoJ - 1].empty()))
+    if (C and C->MaxTwoJ >= twoJ)
         return;
 
-    /// resize d-matrix vector to hold up to spin J
-    if (twoJ > CachedMatrices_.size())
-        CachedMatrices_.resize(twoJ);
+    // copy previous cache and extend it up to spin J
+    std::unique_ptr<Cache> N(C ? new Cache(*C) : new Cache());
+
+    N->Matrices.reserve(twoJ);
+    N->RecurrenceFactors.reserve(twoJ);
+    for (unsigned n = N->MaxTwoJ + 1; n <= twoJ; ++n) {
+        N->Matrices.push_back(kappaFactors(n));
+        N->RecurrenceFactors.emplace_back(n + 1);
+        for (unsigned k = 0; k <= n; ++k)
+            N->RecurrenceFactors.back()[k] = std::sqrt(double(k) / n);
+    }
+    N->MaxTwoJ = twoJ;
 
+    Caches_.emplace_back(N.release());
+    Cache_.store(Caches_.back().get(), std::memory_order_release);
+}
+
+//-------------------------
+dMatrix::dMatrix dMatrix::kappaFactors(unsigned twoJ)
+{
     double J = (double)twoJ / 2;
 
     dMatrix dJ(twoJ + 1);
@@ -118,14 +220,18 @@ void dMatrix::cache(unsigned twoJ)
                                         / std::tgamma(JminusM - K + 1) / std::tgamma(JplusN - K + 1) / std::tgamma(K + MminusN + 1) / std::tgamma(K + 1);
         }
     }
-    CachedMatrices_[twoJ - 1] = dJ;
+    return dJ;
 }
 
 //-------------------------
 unsigned dMatrix::cacheSize()
 {
-    unsigned totSize = sizeof(CachedMatrices_);
-    for (const auto& dJ : CachedMatrices_) {
+    const Cache* C = Cache_.load(std::memory_order_acquire);
+    unsigned totSize = sizeof(Cache_);
+    if (!C)
+        return totSize;
+    totSize += sizeof(*C);
+    for (const auto& dJ : C->Matrices) {
         totSize += sizeof(dJ);
         for (const auto& dJrow : dJ) {
             totSize += sizeof(dJrow);
@@ -134,6 +240,8 @@ unsigned dMatrix::cacheSize()
             }
         }
     }
+    for (const auto& f : C->RecurrenceFactors)
+        totSize += sizeof(f) + f.size() * sizeof(double);
     return totSize;
 }
 
@@ -0,0 +1,92 @@
+#include "WorkStealingScheduler.h"
+
+#include "DataSet.h"
+#include "Exceptions.h"
+#include "make_unique.h"
+#include "Model.h"
+
+#include <algorithm>
+
+namespace yap {
+
+//-------------------------
+DataPartitionVector WorkStealingScheduler::WorkerPartition::createWorkers(const Model& m, unsigned n)
+{
+    if (n == 0)
+        throw exceptions::Exception("number of workers is zero", "WorkStealingScheduler::WorkerPartition::createWorkers");
+
+    DataPartitionVector P;
+    P.reserve(n);
+    for (unsigned i = 0; i < n; ++i)
+        P.push_back(std::make_unique<WorkerPartition>(m.dataAccessors()));
+    return P;
+}
+
+//-------------------------
+WorkStealingScheduler::WorkStealingScheduler(const Model& m, unsigned n_workers, size_t chunk_size) :
+    ChunkSize_(chunk_size > 0 ? chunk_size
+               : std::max<size_t>(1, (256 * 1024) / (sizeof(double) * std::max(m.dataPointSize(), 1u)))),
+    Workers_(WorkerPartition::createWorkers(m, n_workers)),
+    Queues_(n_workers),
+    Pool_(Workers_)
+{
+}
+
+//-------------------------
+bool WorkStealingScheduler::nextChunk(unsigned i, size_t& c)
+{
+    // take from front of own queue
+    {
+        std::lock_guard<std::mutex> lock(Queues_[i].Mutex);
+        if (!Queues_[i].Chunks.empty()) {
+            c = Queues_[i].Chunks.front();
+            Queues_[i].Chunks.pop_front();
+            return true;
+        }
+    }
+
+    // steal from back of others' queues
+    for (unsigned k = 1; k < Queues_.size(); ++k) {
+        auto& Q = Queues_[(i + k) % Queues_.size()];
+        std::lock_guard<std::mutex> lock(Q.Mutex);
+        if (!Q.Chunks.empty()) {
+            c = Q.Chunks.back();
+            Q.Chunks.pop_back();
+            return true;
+        }
+    }
+
+    // chunks are only added by run(), so all work is taken
+    return false;
+}
+
+//-------------------------
+void WorkStealingScheduler::run(DataSet& DS, const Task& task, const Task& finish)
+{
+    // cut data set into chunks of indices, which stay valid however the data set is stored
+    const size_t N = DS.points().size();
+    Chunks_.clear();
+    for (size_t b = 0; b < N; b += ChunkSize_)
+        Chunks_.push_back(std::make_pair(b, std::min(b + ChunkSize_, N)));
+
+    // deal out chunks to workers in contiguous blocks
+    for (unsigned i = 0; i < Queues_.size(); ++i) {
+        std::lock_guard<std::mutex> lock(Queues_[i].Mutex);
+        Queues_[i].Chunks.clear();
+        for (size_t c = i * Chunks_.size() / Queues_.size(); c < (i + 1) * Chunks_.size() / Queues_.size(); ++c)
+            Queues_[i].Chunks.push_back(c);
+    }
+
+    Pool_.run([&](DataPartitionBase & D, unsigned i) {
+        auto& W = static_cast<WorkerPartition&>(D);
+        size_t c;
+        while (nextChunk(i, c)) {
+            W.setChunk(DS, Chunks_[c]);
+            task(W, i);
+        }
+        if (finish)
+            finish(W, i);
+    });
+}
+
+}
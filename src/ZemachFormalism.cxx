@@ -95,9 +95,9 @@ std::complex<double> ZemachSpinAmplitude::calc(int two_M, int two_m1, int two_m2
     FDEBUG("q4 = " << q4);
 
     // boost p and q into R rest frame, and get spacial components
-    auto B = lorentzTransformation<double>(-R4);
-    auto p = vect(B * p4);
-    auto q = vect(B * q4);
+    auto B = lorentzBoost<double>(-R4);
+    auto p = boostedVect(B, p4);
+    auto q = boostedVect(B, q4);
 
     if (twoS() == 2) {
         FDEBUG("p = " << to_string(p));
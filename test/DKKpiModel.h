@@ -0,0 +1,65 @@
+#ifndef yap_DKKpiModel_h
+#define yap_DKKpiModel_h
+
+#include <BreitWigner.h>
+#include <DecayChannel.h>
+#include <DecayingParticle.h>
+#include <FinalStateParticle.h>
+#include <make_unique.h>
+#include <Model.h>
+#include <ParticleFactory.h>
+#include <QuantumNumbers.h>
+#include <Resonance.h>
+#include <ZemachFormalism.h>
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// \struct DKKpiModel
+/// \brief D+ -> K- K+ pi+ through K- pi+ resonances, shared by tests
+struct DKKpiModel {
+    /// model, in Zemach formalism
+    std::unique_ptr<yap::Model> M;
+
+    /// D+, the initial-state particle
+    std::shared_ptr<yap::DecayingParticle> D;
+
+    /// K- pi+ resonances, of spins 0, 1, 2, ... and masses 0.75, 1.00, 1.25, ... GeV,
+    /// each with a Breit-Wigner mass shape of width 0.025 GeV
+    std::vector<std::shared_ptr<yap::Resonance> > piK;
+};
+
+/// \return D+ -> K- K+ pi+ model, with final state (pi+, K-, K+)
+/// \param n_resonances number of K- pi+ resonances
+/// \param resonant_D whether the D+ is a resonance with a Breit-Wigner mass shape
+inline DKKpiModel dkkpiModel(unsigned n_resonances = 2, bool resonant_D = false)
+{
+    auto F = yap::ParticleFactory((std::string)::getenv("YAPDIR") + "/data/evt.pdl");
+
+    auto kPlus  = F.fsp(321);
+    auto kMinus = F.fsp(-321);
+    auto piPlus = F.fsp(211);
+
+    DKKpiModel m;
+    m.M = std::make_unique<yap::Model>(std::make_unique<yap::ZemachFormalism>());
+    m.M->setFinalState({piPlus, kMinus, kPlus});
+
+    if (resonant_D)
+        m.D = F.resonance(411, 3., std::make_shared<yap::BreitWigner>(0.025));
+    else
+        m.D = F.decayingParticle(411, 3.);
+
+    for (unsigned i = 0; i < n_resonances; ++i) {
+        auto r = yap::Resonance::create(yap::QuantumNumbers(2 * i, 0), 0.75 + 0.25 * i, "piK" + std::to_string(i), 3.,
+                                        std::make_shared<yap::BreitWigner>(0.025));
+        r->addChannel({piPlus, kMinus});
+        m.D->addChannel({r, kPlus});
+        m.piK.push_back(r);
+    }
+
+    return m;
+}
+
+#endif
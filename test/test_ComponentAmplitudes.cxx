@@ -0,0 +1,176 @@
+#include <catch.hpp>
+#include <catch_capprox.hpp>
+
+#include "DKKpiModel.h"
+
+#include <BreitWigner.h>
+#include <ComponentAmplitudes.h>
+#include <DecayChannel.h>
+#include <FinalStateParticle.h>
+#include <logging.h>
+#include <MassAxes.h>
+#include <Model.h>
+#include <Resonance.h>
+#include <StatusManager.h>
+
+#include <cmath>
+
+/**
+ * Test that amplitudes calculated from precalculated components
+ * match amplitudes calculated by the model
+ */
+
+/// fill data set with points on a grid over the Dalitz plot
+static void fillDataSet(yap::Model& M, yap::DataSet& data)
+{
+    auto massAxes = M.massAxes({{0, 1}, {1, 2}});
+    const unsigned N = 20;
+    for (unsigned i = 0; i <= N; ++i)
+        for (unsigned j = 0; j <= N; ++j) {
+            auto P = M.calculateFourMomenta(massAxes, {0.4 + 1.5 * i / N, 0.9 + 2.2 * j / N});
+            if (!P.empty())
+                data.add(P);
+        }
+}
+
+/// fix all parameters but the free amplitudes of the initial-state particle's channels
+/// \return free amplitudes of the initial-state particle's channels
+static yap::ParameterSet fixAllButFreeAmplitudes(yap::Model& M)
+{
+    yap::ParameterSet isp_free;
+    for (auto& c : M.initialStateParticle()->channels())
+        for (auto& a : c->freeAmplitudes())
+            isp_free.insert(a);
+    for (auto& da : M.dataAccessors())
+        for (auto& cdv : da->cachedDataValues())
+            for (auto& p : cdv->parameterDependencies())
+                if (isp_free.find(p) == isp_free.end())
+                    p->setVariableStatus(yap::kFixed);
+    return isp_free;
+}
+
+TEST_CASE( "ComponentAmplitudes" )
+{
+
+    // disable logs in text
+    yap::disableLogs(el::Level::Global);
+    //yap::plainLogs(el::Level::Global);
+
+    // D+ -> K+ K- pi+
+    auto KKpi = dkkpiModel();
+    auto& M = *KKpi.M;
+    auto& piK0 = KKpi.piK[0];
+
+    auto data = M.dataSet();
+    fillDataSet(M, data);
+
+    // free parameters are not fixed
+    REQUIRE_FALSE( M.linearInFreeAmplitudes() );
+    REQUIRE_THROWS( yap::ComponentAmplitudes(M, data) );
+
+    // fix all parameters but the ISP's free amplitudes
+    auto isp_free = fixAllButFreeAmplitudes(M);
+
+    REQUIRE( M.linearInFreeAmplitudes() );
+
+    yap::ComponentAmplitudes C(M, data);
+
+    REQUIRE( C.nDataPoints() == data.points().size() );
+    REQUIRE( C.nComponents() == isp_free.size() );
+
+    for (auto free_amps : { std::vector<std::complex<double> >({0.5, 1.}),
+                            std::vector<std::complex<double> >({std::complex<double>(1., -2.), 0.25}),
+                            std::vector<std::complex<double> >({std::complex<double>(0., 1.), std::complex<double>(3., 0.5)})
+                          }) {
+
+        for (size_t k = 0; k < C.nComponents(); ++k)
+            C.freeAmplitudes()[k]->setValue(free_amps[k]);
+
+        for (size_t i = 0; i < data.points().size(); ++i) {
+            yap::StatusManager sm(M.dataAccessors());
+            auto a = M.amplitude(data[i], sm);
+            auto c = C.amplitude(i);
+            REQUIRE( real(c) == Approx(real(a)) );
+            REQUIRE( imag(c) == Approx(imag(a)) );
+        }
+
+        REQUIRE( C.sumOfLogsOfSquaredAmplitudes() == Approx(M.sumOfLogsOfSquaredAmplitudes(data)) );
+    }
+
+    SECTION( "fit mode" ) {
+
+        // sum over full decay tree
+        auto full_sum = [&]() {
+            M.setUseComponentAmplitudes(false);
+            double L = M.sumOfLogsOfSquaredAmplitudes(data);
+            M.setUseComponentAmplitudes(true);
+            return L;
+        };
+
+        M.setUseComponentAmplitudes(true);
+        REQUIRE( M.sumOfLogsOfSquaredAmplitudes(data) == Approx(full_sum()) );
+
+        // changing a free amplitude reuses the components
+        C.freeAmplitudes()[0]->setValue(std::complex<double>(0.3, 0.7));
+        REQUIRE( M.sumOfLogsOfSquaredAmplitudes(data) == Approx(full_sum()) );
+
+        // changing a fixed parameter recalculates them
+        auto width = std::static_pointer_cast<yap::BreitWigner>(piK0->massShape())->width();
+        width->setVariableStatus(yap::kUnchanged);
+        width->setValue(0.05);
+        width->setVariableStatus(yap::kFixed);
+        REQUIRE( M.sumOfLogsOfSquaredAmplitudes(data) == Approx(full_sum()) );
+
+        // and so does changing the data set
+        auto P = M.calculateFourMomenta(M.massAxes({{0, 1}, {1, 2}}), {1.2, 2.});
+        REQUIRE_FALSE( P.empty() );
+        data.add(P);
+        REQUIRE( M.sumOfLogsOfSquaredAmplitudes(data) == Approx(full_sum()) );
+
+        // each data set keeps its own components, so alternating between them
+        // (e.g., data and MC) follows changes to free amplitudes for both
+        auto other = M.dataSet();
+        other.add(P);
+        REQUIRE( std::isfinite(M.sumOfLogsOfSquaredAmplitudes(other)) );
+        C.freeAmplitudes()[1]->setValue(std::complex<double>(-0.2, 0.4));
+        M.setUseComponentAmplitudes(false);
+        const double L_other = M.sumOfLogsOfSquaredAmplitudes(other);
+        M.setUseComponentAmplitudes(true);
+        REQUIRE( M.sumOfLogsOfSquaredAmplitudes(data) == Approx(full_sum()) );
+        REQUIRE( M.sumOfLogsOfSquaredAmplitudes(other) == Approx(L_other) );
+
+        // a parameter that is not fixed leaves the model nonlinear
+        width->setVariableStatus(yap::kUnchanged);
+        REQUIRE( M.sumOfLogsOfSquaredAmplitudes(data) == Approx(full_sum()) );
+    }
+
+}
+
+TEST_CASE( "ComponentAmplitudes_resonantInitialState" )
+{
+
+    // disable logs in text
+    yap::disableLogs(el::Level::Global);
+
+    // D+ -> K+ K- pi+, with the D+ a resonance
+    auto KKpi = dkkpiModel(2, true);
+    auto& M = *KKpi.M;
+
+    auto data = M.dataSet();
+    fillDataSet(M, data);
+
+    fixAllButFreeAmplitudes(M);
+    REQUIRE( M.linearInFreeAmplitudes() );
+
+    yap::ComponentAmplitudes C(M, data);
+
+    // the components include the D's mass shape
+    for (size_t i = 0; i < data.points().size(); ++i) {
+        yap::StatusManager sm(M.dataAccessors());
+        auto a = M.amplitude(data[i], sm);
+        auto c = C.amplitude(i);
+        REQUIRE( real(c) == Approx(real(a)) );
+        REQUIRE( imag(c) == Approx(imag(a)) );
+    }
+
+}
@@ -0,0 +1,715 @@
+#include <catch.hpp>
+#include <catch_capprox.hpp>
+
+#include "DKKpiModel.h"
+
+#include <BreitWigner.h>
+#include <DataPartitionStream.h>
+#include <DependencyGraph.h>
+#include <Exceptions.h>
+#include <FinalStateParticle.h>
+#include <FourMomenta.h>
+#include <FourVector.h>
+#include <HelicityAngles.h>
+#include <logging.h>
+#include <MassAxes.h>
+#include <Model.h>
+#include <ParticleCombination.h>
+#include <Resonance.h>
+#include <spin.h>
+#include <StatusManager.h>
+#include <ThreadPool.h>
+#include <WorkStealingScheduler.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+
+/**
+ * Test that row-major and column-major DataSet's hold the same data
+ * and give the same amplitudes
+ */
+
+TEST_CASE( "DataSet" )
+{
+
+    // disable logs in text
+    yap::disableLogs(el::Level::Global);
+    //yap::plainLogs(el::Level::Global);
+
+    // D+ -> K+ K- pi+
+    auto KKpi = dkkpiModel();
+    auto& M = *KKpi.M;
+    auto& D = KKpi.D;
+    auto& piK0 = KKpi.piK[0];
+    auto& piK1 = KKpi.piK[1];
+    D->channels()[0]->freeAmplitudes()[0]->setValue(0.5 * yap::Complex_1);
+    D->channels()[1]->freeAmplitudes()[0]->setValue(1. * yap::Complex_1);
+
+    auto rows = M.dataSet();
+    auto cols = M.dataSet(0, yap::kColumnMajor);
+
+    REQUIRE( rows.layout() == yap::kRowMajor );
+    REQUIRE( cols.layout() == yap::kColumnMajor );
+
+    // fill both data sets with the same grid over the Dalitz plot
+    auto massAxes = M.massAxes({{0, 1}, {1, 2}});
+    const unsigned N = 20;
+    for (unsigned i = 0; i <= N; ++i)
+        for (unsigned j = 0; j <= N; ++j) {
+            auto P = M.calculateFourMomenta(massAxes, {0.4 + 1.5 * i / N, 0.9 + 2.2 * j / N});
+            if (P.empty())
+                continue;
+            rows.add(P);
+            cols.add(P);
+        }
+
+    REQUIRE( rows.points().size() > 0 );
+    REQUIRE( cols.points().size() == rows.points().size() );
+
+    // points with undefined helicity angles hold NaN's and never compare equal
+    auto comparable = [](const yap::DataPoint & d) { return d == d; };
+
+    SECTION( "data" ) {
+        for (size_t i = 0; i < rows.points().size(); ++i)
+            if (comparable(rows[i]))
+                REQUIRE( rows[i] == cols[i] );
+
+        // columns hold masses of all data points
+        auto pc = M.fourMomenta()->symmetrizationIndices().begin()->first;
+        const double* m = cols.column(*M.fourMomenta()->mass(), 0, M.fourMomenta()->symmetrizationIndex(pc));
+        for (size_t i = 0; i < cols.points().size(); ++i)
+            REQUIRE( m[i] == M.fourMomenta()->m(cols[i], pc) );
+
+        REQUIRE_THROWS( rows.column(*M.fourMomenta()->mass(), 0, 0) );
+    }
+
+    SECTION( "bulk import" ) {
+        // static accessors are ordered by dependence, beginning with four momenta
+        REQUIRE( M.staticDataAccessors().front() == M.fourMomenta().get() );
+
+        // four momenta of all points, one point after another
+        std::vector<yap::FourVector<double> > P;
+        for (unsigned i = 0; i <= N; ++i)
+            for (unsigned j = 0; j <= N; ++j) {
+                auto p = M.calculateFourMomenta(massAxes, {0.4 + 1.5 * i / N, 0.9 + 2.2 * j / N});
+                P.insert(P.end(), p.begin(), p.end());
+            }
+
+        for (auto layout : {yap::kRowMajor, yap::kColumnMajor})
+            for (unsigned n_threads : {1, 2}) {
+                auto bulk = M.dataSet(0, layout);
+                bulk.addPoints(P, n_threads);
+                REQUIRE( bulk.points().size() == rows.points().size() );
+                for (size_t i = 0; i < rows.points().size(); ++i)
+                    if (comparable(rows[i]))
+                        REQUIRE( bulk[i] == rows[i] );
+            }
+
+        // on the threads of a pool, whose partitions belong to another data set
+        auto partitions = yap::DataPartitionBlock::create(rows, 3);
+        yap::ThreadPool pool(partitions);
+        auto pooled = M.dataSet(0, yap::kColumnMajor);
+        pooled.addPoints(P, pool);
+        pooled.addPoints(P, pool);
+        REQUIRE( pooled.points().size() == 2 * rows.points().size() );
+        for (size_t i = 0; i < pooled.points().size(); ++i)
+            if (comparable(rows[i % rows.points().size()]))
+                REQUIRE( pooled[i] == rows[i % rows.points().size()] );
+        for (auto& da : M.dataAccessors())
+            for (auto& cdv : da->cachedDataValues())
+                for (auto& kv : da->symmetrizationIndices())
+                    REQUIRE( pooled.status(*cdv, kv.second) == (da->isStatic() ? yap::kCalculated : yap::kUncalculated) );
+
+        P.pop_back();
+        REQUIRE_THROWS( M.dataSet().addPoints(P) );
+    }
+
+    SECTION( "file" ) {
+        const std::string filename = "test_DataSet.yapdata";
+
+        for (auto& D : {&rows, &cols}) {
+            D->write(filename);
+            auto mapped = M.dataSet(filename);
+
+            REQUIRE( mapped.mapped() );
+            REQUIRE( mapped.layout() == yap::kColumnMajor );
+            REQUIRE( mapped.points().size() == rows.points().size() );
+            for (size_t i = 0; i < rows.points().size(); ++i)
+                if (comparable(rows[i]))
+                    REQUIRE( mapped[i] == rows[i] );
+
+            // parameter-dependent columns are written to anonymous memory
+            REQUIRE( M.sumOfLogsOfSquaredAmplitudes(mapped) == Approx(M.sumOfLogsOfSquaredAmplitudes(cols)) );
+
+            // copies share the mapping; added points do not use it
+            auto copy = mapped;
+            REQUIRE( copy.mapped() );
+            mapped.add(M.calculateFourMomenta(massAxes, {1., 2.}));
+            REQUIRE( !mapped.mapped() );
+            REQUIRE( copy.mapped() );
+            for (size_t i = 0; i < copy.points().size(); ++i)
+                if (comparable(copy[i]))
+                    REQUIRE( mapped[i] == copy[i] );
+        }
+
+        // layout must match model
+        auto M2 = dkkpiModel(1).M;
+        REQUIRE_THROWS( M2->dataSet(filename) );
+
+        std::remove(filename.data());
+        REQUIRE_THROWS( M.dataSet(filename) );
+    }
+
+    SECTION( "stream" ) {
+        const std::string filename = "test_DataSet_stream.yapdata";
+        cols.write(filename);
+
+        // global statuses are managed by a data set of the model
+        auto global = M.dataSet();
+        const double L = M.sumOfLogsOfSquaredAmplitudes(cols);
+
+        for (unsigned n_buffers : {1, 2, 3}) {
+            auto DP = yap::DataPartitionStream::create(M, filename, 2, 50, n_buffers);
+            REQUIRE( DP.size() == 2 );
+
+            // streams restart on every evaluation
+            REQUIRE( M.sumOfLogsOfSquaredAmplitudes(global, DP) == Approx(L) );
+            REQUIRE( M.sumOfLogsOfSquaredAmplitudes(global, DP) == Approx(L) );
+
+            // only static data is read; the rest is recalculated when evaluating
+            size_t n = 0;
+            for (auto& P : DP)
+                for (auto d = P->restart(); d != P->end(); ++d, ++n)
+                    for (auto& kv : M.fourMomenta()->symmetrizationIndices())
+                        REQUIRE( M.fourMomenta()->m(*d, kv.first) == M.fourMomenta()->m(cols[n], kv.first) );
+            REQUIRE( n == cols.points().size() );
+
+            // finished streams must be restarted before iterating again
+            for (auto& P : DP)
+                REQUIRE_FALSE( P->begin() != P->end() );
+        }
+
+        std::remove(filename.data());
+        REQUIRE_THROWS( yap::DataPartitionStream(M, filename) );
+    }
+
+    SECTION( "copy" ) {
+        auto copy = cols;
+        for (size_t i = 0; i < cols.points().size(); ++i) {
+            if (comparable(cols[i]))
+                REQUIRE( copy[i] == cols[i] );
+            REQUIRE( copy[i].dataSet() == &copy );
+        }
+
+        // column-major copies share static columns until written to
+        auto pc = std::find_if(M.fourMomenta()->symmetrizationIndices().begin(), M.fourMomenta()->symmetrizationIndices().end(),
+                               [](const yap::ParticleCombinationMap<unsigned>::value_type & p) { return p.first->indices().size() == 2; })->first;
+        auto m = [&](const yap::DataSet & D) { return D.column(*M.fourMomenta()->mass(), 0, M.fourMomenta()->symmetrizationIndex(pc)); };
+        REQUIRE( m(copy) == m(cols) );
+
+        auto P = M.calculateFourMomenta(massAxes, {1., 2.});
+        auto m0 = M.fourMomenta()->m(cols[0], pc);
+        copy[0].setFinalStateMomenta(P);
+        REQUIRE( m(copy) != m(cols) );
+        REQUIRE( M.fourMomenta()->m(cols[0], pc) == m0 );
+        REQUIRE( M.fourMomenta()->m(copy[0], pc) != m0 );
+
+        // points copied out of a column-major data set own their data
+        auto d = cols[1];
+        if (comparable(cols[1]))
+            REQUIRE( d == cols[1] );
+        yap::StatusManager sm(M.dataAccessors());
+        const double m1 = M.fourMomenta()->m(cols[1], pc);
+        d.setFinalStateMomenta(P, sm);
+        REQUIRE( M.fourMomenta()->m(d, pc) != m1 );
+        REQUIRE( M.fourMomenta()->m(cols[1], pc) == m1 );
+        REQUIRE( m(cols)[1] == m1 );
+    }
+
+    SECTION( "subsets" ) {
+        const double L = M.sumOfLogsOfSquaredAmplitudes(cols);
+        auto sumOfLogs = [&](yap::DataSet D) { return M.sumOfLogsOfSquaredAmplitudes(D); };
+
+        // log-likelihood of each point alone
+        std::vector<double> l(cols.points().size());
+        for (size_t i = 0; i < l.size(); ++i)
+            l[i] = sumOfLogs(cols.subset({i}));
+
+        // subset of all points, in reverse order
+        std::vector<size_t> indices(cols.points().size());
+        for (size_t i = 0; i < indices.size(); ++i)
+            indices[i] = indices.size() - 1 - i;
+        auto reversed = cols.subset(indices);
+        REQUIRE( reversed.points().size() == cols.points().size() );
+        REQUIRE( M.sumOfLogsOfSquaredAmplitudes(reversed) == Approx(L) );
+        for (size_t i = 0; i < indices.size(); ++i)
+            if (comparable(cols[indices[i]]))
+                REQUIRE( reversed[i] == cols[indices[i]] );
+
+        // resampling with repetitions, and subsets of subsets
+        std::vector<unsigned> multiplicities(cols.points().size(), 0);
+        multiplicities[1] = 2;
+        multiplicities[3] = 1;
+        auto resampled = cols.resample(multiplicities);
+        REQUIRE( resampled.points().size() == 3 );
+        REQUIRE( M.sumOfLogsOfSquaredAmplitudes(resampled) == Approx(2 * l[1] + l[3]) );
+        REQUIRE( sumOfLogs(resampled.subset({2, 0})) == Approx(l[3] + l[1]) );
+
+        // subsets share ownership of static data, and copy them when written to
+        auto sub = [&]() { auto copy = cols; return copy.subset({0, 0}); }();
+        REQUIRE( M.sumOfLogsOfSquaredAmplitudes(sub) == Approx(2 * l[0]) );
+        sub.add(M.calculateFourMomenta(massAxes, {1., 2.}));
+        REQUIRE( sub.points().size() == 3 );
+        REQUIRE( M.sumOfLogsOfSquaredAmplitudes(sub) == Approx(2 * l[0] + sumOfLogs(sub.subset({2}))) );
+        REQUIRE( sumOfLogs(cols.subset({0})) == Approx(l[0]) );
+
+        // subsets of mapped data sets
+        const std::string filename = "test_DataSet_subsets.yapdata";
+        cols.write(filename);
+        auto mapped = M.dataSet(filename);
+        REQUIRE( sumOfLogs(mapped.subset(indices)) == Approx(L) );
+        std::remove(filename.data());
+
+        // row-major subsets copy their data points
+        auto rows_resampled = rows.resample(multiplicities);
+        REQUIRE( rows_resampled.layout() == yap::kRowMajor );
+        REQUIRE( rows_resampled[0].dataSet() == &rows_resampled );
+        REQUIRE( M.sumOfLogsOfSquaredAmplitudes(rows_resampled) == Approx(2 * l[1] + l[3]) );
+        REQUIRE( sumOfLogs(rows.subset(indices)) == Approx(L) );
+
+        // writing to a data set copies static columns it has shared, even with a subset
+        auto copy = cols;
+        auto copy_sub = copy.subset({0});
+        copy.add(M.calculateFourMomenta(massAxes, {1., 2.}));
+        REQUIRE( sumOfLogs(copy_sub) == Approx(l[0]) );
+        REQUIRE( sumOfLogs(copy.subset({0})) == Approx(l[0]) );
+
+        REQUIRE_THROWS( cols.subset({cols.points().size()}) );
+        REQUIRE_THROWS( rows.subset({rows.points().size()}) );
+        REQUIRE_THROWS( cols.resample({1}) );
+        REQUIRE_THROWS( reversed.column(*M.fourMomenta()->mass(), 0, 0) );
+    }
+
+    SECTION( "amplitudes" ) {
+        // each point gets statuses of its own, since statuses
+        // set calculating one point would skip the next point
+        for (size_t i = 0; i < rows.points().size(); ++i) {
+            yap::StatusManager sm_row(M.dataAccessors());
+            yap::StatusManager sm_col(M.dataAccessors());
+            auto a_row = M.amplitude(rows[i], sm_row);
+            auto a_col = M.amplitude(cols[i], sm_col);
+            REQUIRE( real(a_row) == Approx(real(a_col)) );
+            REQUIRE( imag(a_row) == Approx(imag(a_col)) );
+        }
+
+        REQUIRE( M.sumOfLogsOfSquaredAmplitudes(rows) == Approx(M.sumOfLogsOfSquaredAmplitudes(cols)) );
+
+        // block evaluation agrees with point-by-point evaluation
+        auto compare = [&]() {
+            std::vector<std::complex<double> > A;
+            cols.updateCalculationStatuses(M.dataAccessors());
+            M.amplitudes(cols, yap::StatusManager(cols), A);
+            REQUIRE( A.size() == cols.points().size() );
+            for (size_t i = 0; i < A.size(); ++i) {
+                yap::StatusManager sm(M.dataAccessors());
+                auto a = M.amplitude(rows[i], sm);
+                REQUIRE( real(A[i]) == Approx(real(a)) );
+                REQUIRE( imag(A[i]) == Approx(imag(a)) );
+            }
+        };
+        compare();
+
+        // only the changed resonance's nodes are recalculated over blocks
+        piK1->mass()->setValue(1.05);
+        compare();
+    }
+
+    SECTION( "all spin projections" ) {
+        for (size_t i = 0; i < rows.points().size(); ++i) {
+            if (!comparable(rows[i]))
+                continue;
+
+            // one traversal over all spin projections agrees with
+            // separate traversals for each spin projection
+            yap::StatusManager sm_all(M.dataAccessors());
+            yap::StatusManager sm_one(M.dataAccessors());
+            auto a_all = M.amplitude(rows[i], sm_all);
+            std::complex<double> a_one = yap::Complex_0;
+            for (int two_m = -D->quantumNumbers().twoJ(); two_m <= (int)D->quantumNumbers().twoJ(); two_m += 2)
+                a_one += M.amplitude(rows[i], two_m, sm_one);
+            REQUIRE( real(a_all) == Approx(real(a_one)) );
+            REQUIRE( imag(a_all) == Approx(imag(a_one)) );
+
+            // compare for each spin projection the resonance has amplitudes for
+            for (auto& kv : piK1->symmetrizationIndices()) {
+                yap::StatusManager sm_r(M.dataAccessors());
+                auto A = piK1->amplitudes(rows[i], kv.first, sm_r);
+                REQUIRE( A.size() == piK1->quantumNumbers().twoJ() + 1 );
+                for (auto& sa : piK1->channel(0)->spinAmplitudes())
+                    for (auto& ap : piK1->channel(0)->amplitudes(sa)) {
+                        auto a = piK1->amplitude(rows[i], kv.first, ap.first, sm_one);
+                        REQUIRE( real(A[yap::spin_projection_index(ap.first, piK1->quantumNumbers().twoJ())]) == Approx(real(a)) );
+                        REQUIRE( imag(A[yap::spin_projection_index(ap.first, piK1->quantumNumbers().twoJ())]) == Approx(imag(a)) );
+                    }
+            }
+        }
+    }
+
+    SECTION( "thread pool" ) {
+        auto partitions = yap::DataPartitionBlock::create(rows, 4);
+        yap::ThreadPool pool(partitions);
+        REQUIRE( pool.size() == 4 );
+
+        double L = M.sumOfLogsOfSquaredAmplitudes(rows);
+
+        // repeated calls reuse the same threads
+        for (unsigned n = 0; n < 3; ++n)
+            REQUIRE( M.sumOfLogsOfSquaredAmplitudes(rows, pool) == Approx(L) );
+        REQUIRE( M.sumOfLogsOfSquaredAmplitudes(rows, partitions) == Approx(L) );
+
+        // exceptions in tasks are rethrown, and the pool remains usable
+        REQUIRE_THROWS( pool.run([](yap::DataPartitionBase&, unsigned i) {if (i == 2) throw yap::exceptions::Exception("", "");}) );
+        REQUIRE( M.sumOfLogsOfSquaredAmplitudes(rows, pool) == Approx(L) );
+
+        // a pool's partitions must belong to the data set evaluated
+        REQUIRE_THROWS( M.sumOfLogsOfSquaredAmplitudes(cols, pool) );
+    }
+
+    SECTION( "work stealing" ) {
+        double L = M.sumOfLogsOfSquaredAmplitudes(rows);
+
+        yap::WorkStealingScheduler scheduler(M, 3, 7);
+        REQUIRE( scheduler.size() == 3 );
+        REQUIRE( scheduler.chunkSize() == 7 );
+
+        // every data point is calculated exactly once per run,
+        // and every worker finishes once
+        std::vector<unsigned> counts(scheduler.size(), 0);
+        std::vector<unsigned> finished(scheduler.size(), 0);
+        scheduler.run(rows, [&](yap::DataPartitionBase & D, unsigned i) {for (auto d = D.begin(); d != D.end(); ++d) ++counts[i];},
+                      [&](yap::DataPartitionBase&, unsigned i) {++finished[i];});
+        REQUIRE( std::accumulate(counts.begin(), counts.end(), 0u) == rows.points().size() );
+        REQUIRE( std::count(finished.begin(), finished.end(), 1u) == 3 );
+
+        for (unsigned n = 0; n < 3; ++n)
+            REQUIRE( M.sumOfLogsOfSquaredAmplitudes(rows, scheduler) == Approx(L) );
+
+        // the same scheduler serves other data sets, and data sets that have grown
+        REQUIRE( M.sumOfLogsOfSquaredAmplitudes(cols, scheduler) == Approx(L) );
+        auto grown = rows;
+        grown.add(M.calculateFourMomenta(massAxes, {1., 2.}));
+        REQUIRE( M.sumOfLogsOfSquaredAmplitudes(grown, scheduler) == Approx(M.sumOfLogsOfSquaredAmplitudes(grown)) );
+
+        // default chunk size
+        yap::WorkStealingScheduler default_scheduler(M, 2);
+        REQUIRE( M.sumOfLogsOfSquaredAmplitudes(cols, default_scheduler) == Approx(L) );
+    }
+
+    SECTION( "status inheritance" ) {
+        auto& cdv = **M.helicityAngles()->cachedDataValues().begin();
+
+        yap::StatusManager global(M.dataAccessors());
+        global.set(cdv, yap::kCalculated);
+
+        yap::StatusManager local(M.dataAccessors());
+        for (unsigned n = 0; n < 3; ++n) {
+            local.inheritCalculationStatuses(global);
+            REQUIRE( local.status(cdv, 0) == yap::kCalculated );
+            local.set(cdv, yap::kUncalculated);
+            REQUIRE( local.status(cdv, 0) == yap::kUncalculated );
+        }
+
+        local.inheritCalculationStatuses(global);
+        local.detachCalculationStatuses();
+        global.set(cdv, yap::kUncalculated);
+        REQUIRE( local.status(cdv, 0) == yap::kCalculated );
+    }
+
+    SECTION( "dependency graph" ) {
+        // mark all parameters unchanged, then change one width
+        for (auto& da : M.dataAccessors())
+            for (auto& cdv : da->cachedDataValues())
+                for (auto& p : cdv->parameterDependencies())
+                    p->setVariableStatus(yap::kUnchanged);
+        std::static_pointer_cast<yap::BreitWigner>(piK0->massShape())->width()->setValue(0.05);
+
+        yap::StatusManager recursive(M.dataAccessors());
+        for (auto& da : M.dataAccessors())
+            recursive.set(*da, yap::kCalculated);
+        recursive.setAll(yap::kUnchanged);
+        yap::StatusManager graph(recursive);
+
+        recursive.updateCalculationStatuses(M.dataAccessors());
+        graph.updateCalculationStatuses(M.dependencyGraph());
+
+        // graph must mark the same statuses uncalculated as the recursive update
+        unsigned n_uncalculated = 0;
+        for (auto& da : M.dataAccessors())
+            for (auto& cdv : da->cachedDataValues())
+                for (auto& kv : da->symmetrizationIndices()) {
+                    REQUIRE( graph.status(*cdv, kv.second).Calculation == recursive.status(*cdv, kv.second).Calculation );
+                    if (graph.status(*cdv, kv.second) == yap::kUncalculated)
+                        ++n_uncalculated;
+                }
+        REQUIRE( n_uncalculated > 0 );
+    }
+
+    SECTION( "parameter change log" ) {
+        auto width = std::static_pointer_cast<yap::BreitWigner>(piK0->massShape())->width();
+
+        yap::StatusManager sm(M.dataAccessors());
+        for (auto& da : M.dataAccessors())
+            sm.set(*da, yap::kCalculated);
+        sm.setAll(yap::kUnchanged);
+
+        // first update reads all parameters changed so far
+        sm.updateCalculationStatuses(M.dependencyGraph());
+        for (auto& da : M.dataAccessors())
+            sm.set(*da, yap::kCalculated);
+
+        auto n_uncalculated = [&]() {
+            unsigned n = 0;
+            for (auto& da : M.dataAccessors())
+                for (auto& cdv : da->cachedDataValues())
+                    for (auto& kv : da->symmetrizationIndices())
+                        if (sm.status(*cdv, kv.second) == yap::kUncalculated)
+                            ++n;
+            return n;
+        };
+
+        // parameters remain flagged as changed,
+        // but are not read again without new changes
+        REQUIRE( width->variableStatus() == yap::kChanged );
+        sm.updateCalculationStatuses(M.dependencyGraph());
+        REQUIRE( n_uncalculated() == 0 );
+
+        // a new change is read
+        width->setValue(0.05);
+        sm.updateCalculationStatuses(M.dependencyGraph());
+        REQUIRE( n_uncalculated() > 0 );
+        for (auto& cdv : piK0->massShape()->cachedDataValues())
+            if (cdv->dependsOn(width))
+                for (auto& kv : piK0->massShape()->symmetrizationIndices())
+                    REQUIRE( sm.status(*cdv, kv.second) == yap::kUncalculated );
+
+        // changes are recorded in the logs of all graphs a parameter belongs to
+        auto log = std::make_shared<yap::ParameterChangeLog>();
+        yap::DependencyGraph G(M.dataAccessors(), log);
+        const auto position = M.dependencyGraph().changeLog()->position();
+        REQUIRE( log->position() == 0 );
+        width->setValue(0.075);
+        REQUIRE( M.dependencyGraph().changeLog()->position() == position + 1 );
+        REQUIRE( log->position() == 1 );
+
+        // rebuilding the model's graph over the same parameters records no changes
+        sm.updateCalculationStatuses(M.dependencyGraph());
+        for (auto& da : M.dataAccessors())
+            sm.set(*da, yap::kCalculated);
+        auto D = M.dataSet();
+        REQUIRE( M.dependencyGraph().changeLog()->position() == position + 1 );
+        REQUIRE( M.dependencyGraph().changeLog()->holds(position + 1) );
+        sm.updateCalculationStatuses(M.dependencyGraph());
+        REQUIRE( n_uncalculated() == 0 );
+    }
+
+    SECTION( "particle combination IDs" ) {
+        // table lookups must agree with the symmetrization-index maps
+        for (auto& da : M.dataAccessors()) {
+            for (auto& kv : da->symmetrizationIndices()) {
+                REQUIRE( kv.first->id() >= 0 );
+                REQUIRE( da->hasParticleCombination(kv.first) );
+                REQUIRE( da->symmetrizationIndex(kv.first) == kv.second );
+            }
+            for (auto& w : M.particleCombinationCache()) {
+                if (w.expired())
+                    continue;
+                auto pc = w.lock();
+                REQUIRE( da->hasParticleCombination(pc) == (da->symmetrizationIndices().find(pc) != da->symmetrizationIndices().end()) );
+            }
+        }
+    }
+
+}
+
+/**
+ * Test that storage settings fix the layout of the data sets created
+ * with them, and that they can't be changed while data sets exist
+ */
+
+TEST_CASE( "DataSet_storage" )
+{
+
+    // disable logs in text
+    yap::disableLogs(el::Level::Global);
+    //yap::plainLogs(el::Level::Global);
+
+    // D+ -> K+ K- pi+
+    auto KKpi = dkkpiModel();
+    auto& M = *KKpi.M;
+    auto& D = KKpi.D;
+    D->channels()[0]->freeAmplitudes()[0]->setValue(0.5 * yap::Complex_1);
+    D->channels()[1]->freeAmplitudes()[0]->setValue(1. * yap::Complex_1);
+
+    // four momenta of a grid over the Dalitz plot, one point after another
+    auto massAxes = M.massAxes({{0, 1}, {1, 2}});
+    std::vector<yap::FourVector<double> > P;
+    const unsigned N = 20;
+    for (unsigned i = 0; i <= N; ++i)
+        for (unsigned j = 0; j <= N; ++j) {
+            auto p = M.calculateFourMomenta(massAxes, {0.4 + 1.5 * i / N, 0.9 + 2.2 * j / N});
+            P.insert(P.end(), p.begin(), p.end());
+        }
+
+    // points with undefined helicity angles hold NaN's and never compare equal
+    auto comparable = [](const yap::DataPoint & d) { return d == d; };
+
+    // evaluate with all static data stored in double precision
+    double L;
+    unsigned size;
+    std::vector<double> phi;
+    {
+        auto cols = M.dataSet(0, yap::kColumnMajor);
+        cols.addPoints(P);
+        L = M.sumOfLogsOfSquaredAmplitudes(cols);
+        size = M.dataPointSize();
+        for (const auto& d : cols.points())
+            for (const auto& kv : M.helicityAngles()->symmetrizationIndices())
+                phi.push_back(M.helicityAngles()->phi(d, kv.first));
+
+        // the layout of existing data sets can't be changed
+        REQUIRE( M.nDataSets() == 1 );
+        REQUIRE_THROWS( M.setStoragePrecision(yap::kSinglePrecision) );
+        REQUIRE_THROWS( M.fourMomenta()->setPrecision(yap::kSinglePrecision) );
+        REQUIRE_THROWS( M.setStoragePolicy(yap::kRecompute) );
+        REQUIRE_THROWS( M.storagePrecisionDifference(P) );
+
+        // but more data sets can be created with it
+        auto rows = M.dataSet();
+        REQUIRE( M.nDataSets() == 2 );
+        REQUIRE( M.dataPointSize() == size );
+    }
+    REQUIRE( M.nDataSets() == 0 );
+
+    // data sets may outlive their model
+    {
+        std::unique_ptr<yap::DataSet> outliving;
+        {
+            auto M2 = dkkpiModel(1).M;
+            outliving = std::make_unique<yap::DataSet>(M2->dataSet());
+            REQUIRE( M2->nDataSets() == 1 );
+        }
+    }
+
+    SECTION( "single precision" ) {
+        REQUIRE( M.storagePrecisionDifference(P) == 0 );
+
+        // data sets created from here on store static data in single precision
+        M.setStoragePrecision(yap::kSinglePrecision);
+        REQUIRE( M.fourMomenta()->precision() == yap::kSinglePrecision );
+
+        const std::string filename = "test_DataSet_single.yapdata";
+        for (auto layout : {yap::kRowMajor, yap::kColumnMajor}) {
+            auto single = M.dataSet(0, layout);
+            single.addPoints(P);
+            REQUIRE( M.dataPointSize() < size );
+
+            single.write(filename);
+            auto mapped = M.dataSet(filename);
+            for (size_t i = 0; i < single.points().size(); ++i)
+                if (comparable(single[i]))
+                    REQUIRE( mapped[i] == single[i] );
+
+            REQUIRE( M.sumOfLogsOfSquaredAmplitudes(single) == Approx(L).epsilon(1e-5) );
+            REQUIRE( M.sumOfLogsOfSquaredAmplitudes(mapped) == M.sumOfLogsOfSquaredAmplitudes(single) );
+
+            if (layout == yap::kColumnMajor)
+                REQUIRE_THROWS( single.column(*M.fourMomenta()->mass(), 0, 0) );
+        }
+        std::remove(filename.data());
+
+        const double dL = M.storagePrecisionDifference(P);
+        REQUIRE( dL != 0 );
+        REQUIRE( std::abs(dL) < 1e-5 * std::abs(L) );
+
+        // precisions, and the layout following from them, are restored after validation
+        REQUIRE( M.fourMomenta()->precision() == yap::kSinglePrecision );
+        REQUIRE( M.dataPointSize() < size );
+        auto single = M.dataSet();
+        single.addPoints(P);
+        REQUIRE( M.sumOfLogsOfSquaredAmplitudes(single) == Approx(L).epsilon(1e-5) );
+    }
+
+    SECTION( "storage policy" ) {
+        REQUIRE( M.recomputedDataSize() == 0 );
+
+        REQUIRE_THROWS( M.fourMomenta()->setStoragePolicy(yap::kRecompute) );
+
+        // data sets created from here on store only four momenta
+        M.setStoragePolicy(yap::kRecompute);
+        for (auto layout : {yap::kRowMajor, yap::kColumnMajor}) {
+            auto D = M.dataSet(0, layout);
+            D.addPoints(P);
+            REQUIRE( M.dataPointSize() < size );
+            REQUIRE( M.recomputedDataSize() > 0 );
+            REQUIRE( M.helicityAngles()->recomputed() );
+            REQUIRE( !M.fourMomenta()->recomputed() );
+
+            REQUIRE( M.sumOfLogsOfSquaredAmplitudes(D) == Approx(L) );
+            auto partitions = yap::DataPartitionBlock::create(D, 2);
+            REQUIRE( M.sumOfLogsOfSquaredAmplitudes(D, partitions) == Approx(L) );
+
+            // values read outside of amplitude calculation must be recomputed explicitly
+            REQUIRE_THROWS( M.helicityAngles()->phi(D[0], M.helicityAngles()->symmetrizationIndices().begin()->first) );
+            size_t n = 0;
+            for (size_t i = 0; i < D.points().size(); ++i) {
+                yap::RecomputedStaticData R(D[i], D);
+                for (const auto& kv : M.helicityAngles()->symmetrizationIndices()) {
+                    if (!std::isnan(phi[n]))
+                        REQUIRE( M.helicityAngles()->phi(D[i], kv.first) == Approx(phi[n]) );
+                    ++n;
+                }
+            }
+        }
+
+        // files record which values were recomputed
+        const std::string filename = "test_DataSet_policy.yapdata";
+        {
+            auto D = M.dataSet(0, yap::kColumnMajor);
+            D.addPoints(P);
+            D.write(filename);
+        }
+
+        // without tuning, kAuto stores
+        M.setStoragePolicy(yap::kAuto);
+        REQUIRE( M.dataSet().model()->dataPointSize() == size );
+
+        // kAuto adopts the policies a file was written with
+        {
+            auto D = M.dataSet(filename);
+            REQUIRE( M.helicityAngles()->recomputed() );
+            REQUIRE( M.sumOfLogsOfSquaredAmplitudes(D) == Approx(L) );
+        }
+        std::remove(filename.data());
+
+        // data sets created from here on store what is cheaper to read than to recalculate
+        M.setStoragePolicy(yap::kAuto);
+        M.tuneStoragePolicy();
+        {
+            auto D = M.dataSet();
+            D.addPoints(P);
+            REQUIRE( M.sumOfLogsOfSquaredAmplitudes(D) == Approx(L) );
+
+            // the policy is resolved once, so the layout stays the same for further data sets
+            const unsigned auto_size = M.dataPointSize();
+            auto D2 = M.dataSet();
+            REQUIRE( M.dataPointSize() == auto_size );
+            REQUIRE_THROWS( M.tuneStoragePolicy() );
+        }
+
+        M.setStoragePolicy(yap::kStore);
+        REQUIRE( M.dataSet().model()->dataPointSize() == size );
+    }
+
+}
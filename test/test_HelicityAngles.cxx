@@ -242,6 +242,11 @@ TEST_CASE( "HelicityAngles" )
                     ") equiv (" << ((phi_thetaRoot[kv.first][0] > yap::pi<double>()/2.) ? (phi_thetaRoot[kv.first][0] - yap::pi<double>()) : (phi_thetaRoot[kv.first][0] + yap::pi<double>())) <<
                             ", " <<  yap::pi<double>() - phi_thetaRoot[kv.first][1] << ")\n";
 
+            // stored cos(theta) and exp(i phi) agree with stored angles
+            REQUIRE( M.helicityAngles()->cosTheta(dp, kv.first) == Approx(cos(M.helicityAngles()->theta(dp, kv.first))) );
+            REQUIRE( real(M.helicityAngles()->expIPhi(dp, kv.first)) == Approx(cos(M.helicityAngles()->phi(dp, kv.first))) );
+            REQUIRE( imag(M.helicityAngles()->expIPhi(dp, kv.first)) == Approx(sin(M.helicityAngles()->phi(dp, kv.first))) );
+
             //REQUIRE( M.helicityAngles()->phi(dp, kv.first)   == Approx(kv.second[0]) );
             //REQUIRE( M.helicityAngles()->theta(dp, kv.first) == Approx(kv.second[1]) );
         }
@@ -7,7 +7,9 @@
 #include <Rotation.h>
 #include <Vector.h>
 
+#include <chrono>
 #include <cmath>
+#include <iostream>
 
 TEST_CASE( "Matrix" )
 {
@@ -99,6 +101,30 @@ TEST_CASE( "Matrix" )
         REQUIRE( abs(vect(lorentzTransformation(-a) * a)) == Approx(0.) );
         REQUIRE( norm(lorentzTransformation(-a) * a) == Approx(norm(a)) );
 
+        // LorentzBoost agrees with Lorentz-transformation matrix
+        for (const auto& v : {a, b, c}) {
+            const auto B = yap::lorentzBoost(-v);
+            REQUIRE( abs(vect(B * v)) < 1e-10 );
+            for (const auto& w : {a, b, c}) {
+                const auto Bw = B * w;
+                const auto Lw = lorentzTransformation(-v) * w;
+                for (unsigned i = 0; i < 4; ++i)
+                    REQUIRE( std::abs(Bw[i] - Lw[i]) < 1e-10 );
+            }
+            const auto L = lorentzTransformation(B);
+            const auto L0 = lorentzTransformation(-v);
+            for (unsigned i = 0; i < 4; ++i)
+                for (unsigned j = 0; j < 4; ++j)
+                    REQUIRE( std::abs(L[i][j] - L0[i][j]) < 1e-10 );
+        }
+
+        // composition of LorentzBoost's agrees with product of matrices
+        const auto AB = yap::lorentzBoost(-a) * yap::lorentzBoost(b);
+        const auto LL = lorentzTransformation(-a) * lorentzTransformation(b);
+        for (unsigned i = 0; i < 4; ++i)
+            for (unsigned j = 0; j < 4; ++j)
+                REQUIRE( std::abs(AB[i][j] - LL[i][j]) < 1e-10 );
+
         // now boost all 4vectors
         std::vector<yap::FourVector<double> > V({a, b, c});
         auto V_boost = lorentzTransformation(-V) * V;
@@ -113,6 +139,27 @@ TEST_CASE( "Matrix" )
         }
     }
 
+    SECTION("fused transformations") {
+
+        const yap::FourVector<double> a({6.2, 0., -1.1, 2.5});
+        const yap::FourVector<double> b({8.6, -0.2, 1.15, 1.5});
+        const auto R = yap::rotation<double>(yap::ThreeVector<double>({0.3, -1.2, 0.7}), 0.9);
+
+        // generic products of 4x4 matrices
+        const auto RB = lorentzTransformation(-a) * lorentzTransformation(R);
+        const auto BR = lorentzTransformation(R) * lorentzTransformation(-a);
+
+        const auto fusedRB = lorentzTransformation(R, yap::lorentzBoost(-a));
+        const auto fusedBR = lorentzTransformation(yap::lorentzBoost(-a), R);
+        for (unsigned i = 0; i < 4; ++i)
+            for (unsigned j = 0; j < 4; ++j) {
+                REQUIRE( std::abs(fusedRB[i][j] - RB[i][j]) < 1e-10 );
+                REQUIRE( std::abs(fusedBR[i][j] - BR[i][j]) < 1e-10 );
+            }
+
+        REQUIRE( abs(boostedVect(yap::lorentzBoost(-a), b) - vect(lorentzTransformation(-a) * b)) < 1e-10 );
+    }
+
     SECTION("ThreeVector rotations") {
 
         for (double alpha = 0; alpha < 3.5; alpha += 0.2) {
@@ -241,3 +288,66 @@ TEST_CASE( "Matrix" )
 
     }
 }
+
+// timing of fused against generic transformations; hidden from normal runs,
+// run with yap_test "[benchmark]"
+TEST_CASE( "Matrix benchmark", "[.][benchmark]" )
+{
+
+    const unsigned N = 100000;
+    const yap::FourVector<double> a({6.2, 0., -1.1, 2.5});
+    const yap::FourVector<double> b({8.6, -0.2, 1.15, 1.5});
+    const yap::FourVector<double> c({6.9, 0.55, 2., -2.3});
+    const auto R = yap::rotation<double>(yap::ThreeVector<double>({0.3, -1.2, 0.7}), 0.9);
+
+    // boost matrix built from temporaries, as before fused routines
+    auto generic_boost = [](const yap::FourVector<double>& V) {
+        auto gamma = V[0] / abs(V);
+        auto b = yap::FourVector<double>((gamma + 1), gamma * vect(V) / V[0]) / sqrt(gamma + 1);
+        return yap::diagonalMatrix<double, 4>({ -1, 1, 1, 1}) + outer(b, b);
+    };
+
+    // boost-then-dot, as in the Zemach formalism
+    double sum_generic = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned n = 0; n < N; ++n) {
+        const yap::FourVector<double> v(a + (1e-6 * n) * c);
+        const auto L = generic_boost(-v);
+        const auto b0 = vect(L * b);
+        const auto c0 = vect(L * c);
+        sum_generic += b0 * c0;
+    }
+    const std::chrono::duration<double, std::milli> t_generic = std::chrono::steady_clock::now() - start;
+
+    double sum_fused = 0;
+    start = std::chrono::steady_clock::now();
+    for (unsigned n = 0; n < N; ++n) {
+        const yap::FourVector<double> v(a + (1e-6 * n) * c);
+        const auto B = yap::lorentzBoost(-v);
+        sum_fused += boostedVect(B, b) * boostedVect(B, c);
+    }
+    const std::chrono::duration<double, std::milli> t_fused = std::chrono::steady_clock::now() - start;
+
+    REQUIRE( sum_fused == Approx(sum_generic) );
+    std::cout << "boost-then-dot:    generic " << t_generic.count() << " ms, fused " << t_fused.count() << " ms\n";
+
+    // rotate-then-boost
+    sum_generic = 0;
+    start = std::chrono::steady_clock::now();
+    for (unsigned n = 0; n < N; ++n) {
+        const yap::FourVector<double> v(a + (1e-6 * n) * c);
+        sum_generic += (generic_boost(-v) * lorentzTransformation(R))[1][2];
+    }
+    const std::chrono::duration<double, std::milli> t_generic_RB = std::chrono::steady_clock::now() - start;
+
+    sum_fused = 0;
+    start = std::chrono::steady_clock::now();
+    for (unsigned n = 0; n < N; ++n) {
+        const yap::FourVector<double> v(a + (1e-6 * n) * c);
+        sum_fused += lorentzTransformation(R, yap::lorentzBoost(-v))[1][2];
+    }
+    const std::chrono::duration<double, std::milli> t_fused_RB = std::chrono::steady_clock::now() - start;
+
+    REQUIRE( sum_fused == Approx(sum_generic) );
+    std::cout << "rotate-then-boost: generic " << t_generic_RB.count() << " ms, fused " << t_fused_RB.count() << " ms\n";
+}
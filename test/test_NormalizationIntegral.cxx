@@ -0,0 +1,130 @@
+#include <catch.hpp>
+#include <catch_capprox.hpp>
+
+#include "DKKpiModel.h"
+
+#include <BreitWigner.h>
+#include <DecayChannel.h>
+#include <FinalStateParticle.h>
+#include <logging.h>
+#include <MassAxes.h>
+#include <Model.h>
+#include <NormalizationIntegral.h>
+#include <Resonance.h>
+#include <StatusManager.h>
+#include <ThreadPool.h>
+
+#include <cmath>
+
+/**
+ * Test that the normalization integral matches the sum of squared
+ * amplitudes over the data set, also after changing parameters
+ */
+
+/// \return sum of squared amplitudes over data set, calculated from scratch
+double sumOfSquaredAmplitudes(const yap::Model& M, yap::DataSet& data)
+{
+    double I = 0;
+    for (size_t i = 0; i < data.points().size(); ++i) {
+        yap::StatusManager sm(M.dataAccessors());
+        I += norm(M.amplitude(data[i], sm));
+    }
+    return I;
+}
+
+TEST_CASE( "NormalizationIntegral" )
+{
+
+    // disable logs in text
+    yap::disableLogs(el::Level::Global);
+    //yap::plainLogs(el::Level::Global);
+
+    // D+ -> K+ K- pi+
+    auto KKpi = dkkpiModel(3);
+    auto& M = *KKpi.M;
+    auto& D = KKpi.D;
+    auto bw0 = std::static_pointer_cast<yap::BreitWigner>(KKpi.piK[0]->massShape());
+
+    auto data = M.dataSet();
+
+    auto massAxes = M.massAxes({{0, 1}, {1, 2}});
+    const unsigned N = 20;
+    for (unsigned i = 0; i <= N; ++i)
+        for (unsigned j = 0; j <= N; ++j) {
+            auto P = M.calculateFourMomenta(massAxes, {0.4 + 1.5 * i / N, 0.9 + 2.2 * j / N});
+            if (!P.empty())
+                data.add(P);
+        }
+
+    auto partitions = yap::DataPartitionBlock::create(data, 3);
+    yap::ThreadPool pool(partitions);
+
+    yap::NormalizationIntegral I(M);
+
+    REQUIRE( I.terms().size() == 3 );
+
+    I.update(data, pool);
+    REQUIRE( I.nDataPoints() == data.points().size() );
+    REQUIRE( I.integral() == Approx(sumOfSquaredAmplitudes(M, data)) );
+
+    // interference matrix is hermitian
+    for (size_t j = 0; j < I.terms().size(); ++j)
+        for (size_t k = 0; k < I.terms().size(); ++k) {
+            REQUIRE( real(I.interference(j, k)) == Approx(real(I.interference(k, j))) );
+            REQUIRE( imag(I.interference(j, k)) == Approx(-imag(I.interference(k, j))) );
+        }
+
+    // fix all parameters but the ISP's free amplitudes and one width
+    yap::ParameterSet free;
+    for (auto& c : D->channels())
+        for (auto& a : c->freeAmplitudes())
+            free.insert(a);
+    free.insert(bw0->width());
+    for (auto& da : M.dataAccessors())
+        for (auto& cdv : da->cachedDataValues())
+            for (auto& p : cdv->parameterDependencies())
+                if (free.find(p) == free.end())
+                    p->setVariableStatus(yap::kFixed);
+
+    SECTION( "free amplitudes changed" ) {
+        I.terms()[0].Free->setValue(std::complex<double>(0.5, -1.));
+        I.terms()[2].Free->setValue(std::complex<double>(2., 0.25));
+        I.update(data, pool);
+        REQUIRE( I.integral() == Approx(sumOfSquaredAmplitudes(M, data)) );
+    }
+
+    SECTION( "width changed" ) {
+        I.terms()[1].Free->setValue(std::complex<double>(0., 3.));
+        bw0->width()->setValue(0.05);
+        I.update(data, pool);
+        REQUIRE( I.integral() == Approx(sumOfSquaredAmplitudes(M, data)) );
+    }
+
+    SECTION( "single partition" ) {
+        bw0->width()->setValue(0.1);
+        I.update(data);
+        REQUIRE( I.integral() == Approx(sumOfSquaredAmplitudes(M, data)) );
+    }
+
+    SECTION( "data set changed" ) {
+        auto P = M.calculateFourMomenta(massAxes, {1.2, 2.});
+        REQUIRE_FALSE( P.empty() );
+        data.add(P);
+        I.update(data);
+        REQUIRE( I.nDataPoints() == data.points().size() );
+        REQUIRE( I.integral() == Approx(sumOfSquaredAmplitudes(M, data)) );
+    }
+
+    SECTION( "model evaluated after update" ) {
+        // updating leaves the data set's statuses valid for the model
+        bw0->width()->setValue(0.04);
+        I.update(data, pool);
+        double L = 0;
+        for (size_t i = 0; i < data.points().size(); ++i) {
+            yap::StatusManager sm(M.dataAccessors());
+            L += log(norm(M.amplitude(data[i], sm)));
+        }
+        REQUIRE( M.sumOfLogsOfSquaredAmplitudes(data) == Approx(L) );
+    }
+
+}
@@ -6,6 +6,7 @@
 #include <logging.h>
 
 #include <cmath>
+#include <type_traits>
 
 TEST_CASE( "Vector" )
 {
@@ -116,6 +117,19 @@ TEST_CASE( "Vector" )
             REQUIRE( v1 == yap::FourVector<double>({8, 6, 4, 2}) );
         }
 
+        SECTION( "layout" ) {
+            // four-vectors hold nothing but their elements
+            REQUIRE( sizeof(yap::FourVector<double>) == 4 * sizeof(double) );
+            REQUIRE( std::is_trivially_copyable<yap::FourVector<double> >::value );
+            REQUIRE( std::is_standard_layout<yap::FourVector<double> >::value );
+            REQUIRE( std::is_trivially_copyable<yap::ThreeVector<double> >::value );
+
+            // the inner product is chosen by the static type
+            const yap::Vector<double, 4>& v1_base = v1;
+            REQUIRE( norm(v1) == 2 );
+            REQUIRE( norm(v1_base) == 30 );
+        }
+
         SECTION( "arithmetic operations" ) {
 
             // +
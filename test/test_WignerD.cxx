@@ -5,9 +5,11 @@
 #include <Exceptions.h>
 #include <logging.h>
 #include <MathUtilities.h>
+#include <spin.h>
 #include <WignerD.h>
 
 #include <cmath>
+#include <vector>
 
 void checkDSymmetries(unsigned twoJ, int twoM, int twoN, double alpha, double beta, double gamma)
 {
@@ -33,6 +35,19 @@ TEST_CASE( "WignerD" )
         REQUIRE_NOTHROW( yap::dMatrix::cache(1) );
     }
 
+    SECTION( "Recurrence" ) {
+        std::vector<double> d;
+        for (unsigned twoJ = 0; twoJ <= 8; ++twoJ)
+            for (double b : {0., 0.1 * yap::pi<double>(), beta, yap::pi<double>()}) {
+                yap::dMatrix::calculate(twoJ, cos(b), d);
+                REQUIRE( d.size() == (twoJ + 1) * (twoJ + 1) );
+                for (int twoM = -twoJ; twoM <= (int)twoJ; twoM += 2)
+                    for (int twoN = -twoJ; twoN <= (int)twoJ; twoN += 2)
+                        REQUIRE( std::abs(d[yap::spin_projection_index(twoM, twoJ) * (twoJ + 1) + yap::spin_projection_index(twoN, twoJ)]
+                                          - yap::dFunction(twoJ, twoM, twoN, b)) < 1e-12 );
+            }
+    }
+
     SECTION( "J = 0") {
         SECTION ("d matrix") {
             // check invalid args